@@ -0,0 +1,41 @@
+#include <thread>
+#include "benchmark/benchmark.h"
+
+#include "GraphInf/rng.h"
+#include "GraphInf/graph/erdosrenyi.h"
+#include "GraphInf/data/dynamics/sis.h"
+
+namespace GraphInf
+{
+
+    // SIS posterior sweep with speculation width `range(0)` over N=`range(1)`, T=`range(2)`.
+    static void BM_SIS_speculativeGraphSweep(benchmark::State &state)
+    {
+        seed(1);
+        const size_t numSteps = 1000;
+        ErdosRenyiModel prior(state.range(1), 2.5 * state.range(1));
+        SISDynamics dynamics(prior, state.range(2), 0.5, 0.3);
+        dynamics.sample();
+        dynamics.setSpeculationWidth(state.range(0));
+        dynamics.setThreadCount(std::min<size_t>(state.range(0), std::thread::hardware_concurrency()));
+        for (auto _ : state)
+            benchmark::DoNotOptimize(dynamics.metropolisGraphSweep(numSteps));
+        state.SetItemsProcessed(state.iterations() * numSteps);
+    }
+    BENCHMARK(BM_SIS_speculativeGraphSweep)->ArgsProduct({{1, 2, 4, 8}, {1000}, {100, 1000}})->UseRealTime();
+
+    // SIS greedy step scoring `range(1)` candidates on `range(0)` threads, N=1000, T=100.
+    static void BM_SIS_greedyGraphStep(benchmark::State &state)
+    {
+        seed(1);
+        ErdosRenyiModel prior(1000, 2500);
+        SISDynamics dynamics(prior, 100, 0.5, 0.3);
+        dynamics.sample();
+        dynamics.setThreadCount(state.range(0));
+        for (auto _ : state)
+            benchmark::DoNotOptimize(dynamics.greedyGraphStep(state.range(1)));
+        state.SetItemsProcessed(state.iterations() * state.range(1));
+    }
+    BENCHMARK(BM_SIS_greedyGraphStep)->ArgsProduct({{1, 2, 4, 8}, {50, 500}})->UseRealTime();
+
+}
@@ -0,0 +1,248 @@
+#include <vector>
+#include <random>
+#include "benchmark/benchmark.h"
+
+#include "GraphInf/rng.h"
+#include "GraphInf/graph/erdosrenyi.h"
+#include "GraphInf/data/dynamics/sis.h"
+#include "GraphInf/data/dynamics/glauber.h"
+#include "GraphInf/data/dynamics/cowan.h"
+#include "GraphInf/data/dynamics/log_transition_kernels.h"
+
+namespace GraphInf
+{
+
+    // Log-likelihood ratio of one graph move per item, cycling through 1000 proposals.
+    static void runGraphMoveRatioBenchmark(benchmark::State &state, RandomGraph &prior, Dynamics &dynamics)
+    {
+        dynamics.sample();
+        std::vector<GraphMove> moves;
+        for (size_t i = 0; i < 1000; i++)
+            moves.push_back(prior.proposeGraphMove());
+        size_t i = 0;
+        for (auto _ : state)
+            benchmark::DoNotOptimize(dynamics.getLogLikelihoodRatioFromGraphMove(moves[i++ % moves.size()]));
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    static void setDynamicsArgs(benchmark::internal::Benchmark *bench)
+    {
+        bench->ArgNames({"N", "E", "T"})->ArgsProduct({{100, 1000}, {2500}, {100, 1000}});
+    }
+
+    static void BM_SIS_logLikelihoodRatioFromGraphMove(benchmark::State &state)
+    {
+        seed(1);
+        ErdosRenyiModel prior(state.range(0), state.range(1));
+        SISDynamics dynamics(prior, state.range(2), 0.5, 0.3);
+        runGraphMoveRatioBenchmark(state, prior, dynamics);
+    }
+    BENCHMARK(BM_SIS_logLikelihoodRatioFromGraphMove)->Apply(setDynamicsArgs);
+
+    /* Log-likelihood ratio of one graph move per item, with sequences held
+     * one int per cell (`packed=0`) or one bit per cell (`packed=1`). */
+    static void BM_SIS_logLikelihoodRatioFromGraphMoveWithPacking(benchmark::State &state)
+    {
+        seed(1);
+        ErdosRenyiModel prior(state.range(0), state.range(1));
+        SISDynamics dynamics(prior, state.range(2), 0.5, 0.3);
+        dynamics.setStatePacking(state.range(3));
+        runGraphMoveRatioBenchmark(state, prior, dynamics);
+    }
+    BENCHMARK(BM_SIS_logLikelihoodRatioFromGraphMoveWithPacking)->ArgNames({"N", "E", "T", "packed"})->ArgsProduct({{1000}, {2500}, {100, 1000}, {0, 1}});
+
+    /* Log-likelihood ratio of one graph move per item, with the neighbour
+     * counts stored (`cache=1`) or counted from the neighbours' past states
+     * (`cache=0`). */
+    static void BM_SIS_logLikelihoodRatioFromGraphMoveWithNeighborCaching(benchmark::State &state)
+    {
+        seed(1);
+        ErdosRenyiModel prior(state.range(0), state.range(1));
+        SISDynamics dynamics(prior, state.range(2), 0.5, 0.3);
+        dynamics.setNeighborsPastStateCaching(state.range(3));
+        runGraphMoveRatioBenchmark(state, prior, dynamics);
+    }
+    BENCHMARK(BM_SIS_logLikelihoodRatioFromGraphMoveWithNeighborCaching)->ArgNames({"N", "E", "T", "cache"})->ArgsProduct({{1000}, {2500}, {100, 1000}, {0, 1}});
+
+    /* Full log-likelihood recomputation per item (the cache is disabled),
+     * with vertex-major (`layout=0`) or time-major (`layout=1`) sequences,
+     * on `threads` threads. */
+    static void BM_SIS_logLikelihood(benchmark::State &state)
+    {
+        seed(1);
+        ErdosRenyiModel prior(state.range(0), state.range(1));
+        SISDynamics dynamics(prior, state.range(2), 0.5, 0.3);
+        dynamics.sample();
+        dynamics.setSequenceLayout(state.range(3) ? SequenceLayout::TimeMajor : SequenceLayout::VertexMajor);
+        dynamics.setLogLikelihoodCaching(false);
+        dynamics.setThreadCount(state.range(4));
+        for (auto _ : state)
+            benchmark::DoNotOptimize(dynamics.getLogLikelihood());
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_SIS_logLikelihood)->ArgNames({"N", "E", "T", "layout", "threads"})->ArgsProduct({{1000}, {2500}, {100, 1000}, {0, 1}, {1, 4}});
+
+    /* Loading of an observed N x T sequence per item: neighbour counts,
+     * likelihood cache and transition counts, on `threads` threads. */
+    static void BM_SIS_setState(benchmark::State &state)
+    {
+        seed(1);
+        ErdosRenyiModel prior(state.range(0), state.range(1));
+        SISDynamics dynamics(prior, state.range(2), 0.5, 0.3);
+        dynamics.sample();
+        dynamics.setThreadCount(state.range(3));
+        const Matrix<VertexState> past = dynamics.getPastStates(), future = dynamics.getFutureStates();
+        for (auto _ : state)
+            dynamics.setState(past, future);
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_SIS_setState)->ArgNames({"N", "E", "T", "threads"})->ArgsProduct({{1000}, {2500}, {100, 1000}, {1, 4}});
+
+    /* Sliding of a window of `T` steps by 10 new steps per item, with
+     * appendStates (`append=1`) or setState on the whole window
+     * (`append=0`), on time-major sequences. */
+    static void BM_SIS_slideWindow(benchmark::State &state)
+    {
+        seed(1);
+        const size_t length = state.range(2), numNewSteps = 10;
+        ErdosRenyiModel prior(state.range(0), state.range(1));
+        SISDynamics dynamics(prior, length, 0.5, 0.3);
+        dynamics.sample();
+        dynamics.setSequenceLayout(SequenceLayout::TimeMajor);
+        const Matrix<VertexState> states = dynamics.getPastStates();
+        Matrix<VertexState> window = states, newStates(states.size());
+        for (size_t v = 0; v < states.size(); v++)
+        {
+            window[v].push_back(dynamics.getFutureStates()[v][length - 1]);
+            newStates[v].assign(states[v].begin(), states[v].begin() + numNewSteps);
+        }
+        for (auto _ : state)
+        {
+            if (state.range(3))
+                dynamics.appendStates(newStates, length);
+            else
+                dynamics.setState(window);
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_SIS_slideWindow)->ArgNames({"N", "E", "T", "append"})->ArgsProduct({{1000}, {2500}, {100, 1000}, {0, 1}});
+
+    /* Log-likelihood ratio of one infection-probability move per item, from
+     * the transition counts (`cache=1`) or two full passes (`cache=0`). */
+    static void BM_SIS_logLikelihoodRatioFromParaMove(benchmark::State &state)
+    {
+        seed(1);
+        ErdosRenyiModel prior(state.range(0), state.range(1));
+        SISDynamics dynamics(prior, state.range(2), 0.5, 0.3);
+        dynamics.sample();
+        dynamics.setLogLikelihoodCaching(state.range(3));
+        const ParamMove move("infection", 0.01);
+        for (auto _ : state)
+            benchmark::DoNotOptimize(dynamics.getLogLikelihoodRatioFromParaMove(move));
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_SIS_logLikelihoodRatioFromParaMove)->ArgNames({"N", "E", "T", "cache"})->ArgsProduct({{1000}, {2500}, {100, 1000}, {0, 1}});
+
+    /* One accepted infection-probability move followed by the ratio of one
+     * graph move per item: only the vertices of the graph move have their
+     * cached log-likelihood recomputed. */
+    static void BM_SIS_applyParamMoveThenGraphMoveRatio(benchmark::State &state)
+    {
+        seed(1);
+        ErdosRenyiModel prior(state.range(0), state.range(1));
+        SISDynamics dynamics(prior, state.range(2), 0.5, 0.3);
+        dynamics.sample();
+        double step = 0.01;
+        for (auto _ : state)
+        {
+            dynamics.applyParamMove({"infection", step});
+            step = -step;
+            benchmark::DoNotOptimize(dynamics.getLogLikelihoodRatioFromGraphMove(prior.proposeGraphMove()));
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_SIS_applyParamMoveThenGraphMoveRatio)->ArgNames({"N", "E", "T"})->ArgsProduct({{1000}, {2500}, {100, 1000}});
+
+    /* Sum of the log transition probabilities of one vertex over `T` steps,
+     * shifted by one added edge, with the scalar (`simd=0`), SSE4 (`simd=1`)
+     * or AVX2 (`simd=2`) kernel. */
+    static void BM_sumLogTransitions(benchmark::State &state)
+    {
+        std::mt19937 rng(1);
+        const size_t length = state.range(0);
+        std::vector<double> values(4 * 64 * 64, -1);
+        std::vector<VertexState> past(length), future(length), otherPast(length), counts(2 * length);
+        for (size_t t = 0; t < length; t++)
+        {
+            past[t] = rng() % 2;
+            future[t] = rng() % 2;
+            otherPast[t] = rng() % 2;
+            counts[2 * t] = rng() % 32;
+            counts[2 * t + 1] = rng() % 32;
+        }
+        const LogTransitionTable table = {values.data(), 64, 64, 64};
+        const NeighborShift shift = {otherPast.data(), 1};
+        double sum;
+        for (auto _ : state)
+        {
+            sumLogTransitions(table, past.data(), future.data(), counts.data(), &shift, 1, length, sum, SimdLevel(state.range(1)));
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(state.iterations() * length);
+    }
+    BENCHMARK(BM_sumLogTransitions)->ArgNames({"T", "simd"})->ArgsProduct({{1000, 10000}, {0, 1, 2}});
+
+    /* Sampling of a synchronous trajectory of `T` steps on a fixed graph per
+     * item, on `threads` threads. */
+    static void BM_SIS_sampleState(benchmark::State &state)
+    {
+        seed(1);
+        ErdosRenyiModel prior(state.range(0), state.range(1));
+        SISDynamics dynamics(prior, state.range(2), 0.5, 0.3);
+        dynamics.sample();
+        dynamics.setThreadCount(state.range(3));
+        for (auto _ : state)
+            dynamics.sampleState();
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_SIS_sampleState)->ArgNames({"N", "E", "T", "threads"})->ArgsProduct({{1000}, {2500}, {100, 1000}, {1, 4}});
+
+    /* Sampling of a subcritical SIS trajectory of `T` steps per item, with
+     * synchronous steps (`events=0`) or the event-driven simulation
+     * (`events=1`). */
+    static void BM_SIS_sampleStateNearExtinction(benchmark::State &state)
+    {
+        seed(1);
+        ErdosRenyiModel prior(state.range(0), state.range(1));
+        SISDynamics dynamics(prior, state.range(2), 0.05, 0.5, 0, 0);
+        dynamics.sample();
+        for (auto _ : state)
+        {
+            if (state.range(3))
+                dynamics.sampleStateFromEvents();
+            else
+                dynamics.sampleState();
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_SIS_sampleStateNearExtinction)->ArgNames({"N", "E", "T", "events"})->ArgsProduct({{2000}, {4000}, {100, 1000}, {0, 1}});
+
+    static void BM_Glauber_logLikelihoodRatioFromGraphMove(benchmark::State &state)
+    {
+        seed(1);
+        ErdosRenyiModel prior(state.range(0), state.range(1));
+        GlauberDynamics dynamics(prior, state.range(2), 0.5);
+        runGraphMoveRatioBenchmark(state, prior, dynamics);
+    }
+    BENCHMARK(BM_Glauber_logLikelihoodRatioFromGraphMove)->Apply(setDynamicsArgs);
+
+    static void BM_Cowan_logLikelihoodRatioFromGraphMove(benchmark::State &state)
+    {
+        seed(1);
+        ErdosRenyiModel prior(state.range(0), state.range(1));
+        CowanDynamics dynamics(prior, state.range(2));
+        runGraphMoveRatioBenchmark(state, prior, dynamics);
+    }
+    BENCHMARK(BM_Cowan_logLikelihoodRatioFromGraphMove)->Apply(setDynamicsArgs);
+
+}
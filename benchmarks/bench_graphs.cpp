@@ -0,0 +1,80 @@
+#include "benchmark/benchmark.h"
+
+#include "GraphInf/rng.h"
+#include "GraphInf/graph/erdosrenyi.h"
+#include "GraphInf/graph/configuration.h"
+#include "GraphInf/graph/sbm.h"
+#include "GraphInf/graph/dcsbm.h"
+#include "GraphInf/graph/hsbm.h"
+#include "GraphInf/graph/hdcsbm.h"
+
+namespace GraphInf
+{
+
+    // One Metropolis graph step per item.
+    static void runGraphStepBenchmark(benchmark::State &state, RandomGraph &graph)
+    {
+        for (auto _ : state)
+            benchmark::DoNotOptimize(graph.metropolisGraphStep());
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    static void setGraphArgs(benchmark::internal::Benchmark *bench)
+    {
+        bench->ArgNames({"N", "E"})->Args({100, 250})->Args({1000, 2500})->Args({1000, 10000});
+    }
+    static void setBlockGraphArgs(benchmark::internal::Benchmark *bench)
+    {
+        bench->ArgNames({"N", "E", "B"})->Args({100, 250, 3})->Args({1000, 2500, 3})->Args({1000, 2500, 10})->Args({1000, 10000, 10});
+    }
+
+    static void BM_ER_metropolisGraphStep(benchmark::State &state)
+    {
+        seed(1);
+        ErdosRenyiModel graph(state.range(0), state.range(1));
+        runGraphStepBenchmark(state, graph);
+    }
+    BENCHMARK(BM_ER_metropolisGraphStep)->Apply(setGraphArgs);
+
+    static void BM_CM_metropolisGraphStep(benchmark::State &state)
+    {
+        seed(1);
+        ConfigurationModelFamily graph(state.range(0), state.range(1));
+        runGraphStepBenchmark(state, graph);
+    }
+    BENCHMARK(BM_CM_metropolisGraphStep)->Apply(setGraphArgs);
+
+    static void BM_SBM_metropolisGraphStep(benchmark::State &state)
+    {
+        seed(1);
+        StochasticBlockModelFamily graph(state.range(0), state.range(1), state.range(2));
+        runGraphStepBenchmark(state, graph);
+    }
+    BENCHMARK(BM_SBM_metropolisGraphStep)->Apply(setBlockGraphArgs);
+
+    static void BM_DCSBM_metropolisGraphStep(benchmark::State &state)
+    {
+        seed(1);
+        DegreeCorrectedStochasticBlockModelFamily graph(state.range(0), state.range(1), state.range(2));
+        runGraphStepBenchmark(state, graph);
+    }
+    BENCHMARK(BM_DCSBM_metropolisGraphStep)->Apply(setBlockGraphArgs);
+
+    // The nested models sample their own hierarchy, so they take no `B`.
+    static void BM_NestedSBM_metropolisGraphStep(benchmark::State &state)
+    {
+        seed(1);
+        NestedStochasticBlockModelFamily graph(state.range(0), state.range(1));
+        runGraphStepBenchmark(state, graph);
+    }
+    BENCHMARK(BM_NestedSBM_metropolisGraphStep)->Apply(setGraphArgs);
+
+    static void BM_NestedDCSBM_metropolisGraphStep(benchmark::State &state)
+    {
+        seed(1);
+        NestedDegreeCorrectedStochasticBlockModelFamily graph(state.range(0), state.range(1));
+        runGraphStepBenchmark(state, graph);
+    }
+    BENCHMARK(BM_NestedDCSBM_metropolisGraphStep)->Apply(setGraphArgs);
+
+}
@@ -0,0 +1,27 @@
+#include "benchmark/benchmark.h"
+
+#include "GraphInf/rng.h"
+#include "GraphInf/graph/sbm.h"
+
+namespace GraphInf
+{
+
+    /* One Metropolis label step per item on an SBM of `N` vertices, `E` edges
+     * and `B` blocks, with the uniform (`mixed=0`) or mixed (`mixed=1`) block
+     * proposer in its Gibbs (`restricted=0`) or restricted (`restricted=1`)
+     * form. The restricted proposers go with the block hyperprior. */
+    static void BM_SBM_metropolisLabelStep(benchmark::State &state)
+    {
+        seed(1);
+        const bool restricted = state.range(4);
+        StochasticBlockModelFamily graph(state.range(0), state.range(1), state.range(2), restricted, false, false, true, true, true,
+                                         state.range(3) ? "mixed" : "uniform");
+        for (auto _ : state)
+            benchmark::DoNotOptimize(graph.metropolisParamStep());
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_SBM_metropolisLabelStep)
+        ->ArgNames({"N", "E", "B", "mixed", "restricted"})
+        ->ArgsProduct({{100, 1000}, {2500}, {3, 10}, {0, 1}, {0, 1}});
+
+}
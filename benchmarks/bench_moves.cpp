@@ -0,0 +1,57 @@
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include "benchmark/benchmark.h"
+
+#include "GraphInf/rng.h"
+#include "GraphInf/graph/erdosrenyi.h"
+#include "GraphInf/graph/configuration.h"
+
+// Counts the heap allocations of the whole binary, reported per MCMC step.
+static std::atomic<size_t> allocationCount(0);
+
+void *operator new(size_t size)
+{
+    allocationCount++;
+    if (void *ptr = std::malloc(size ? size : 1))
+        return ptr;
+    throw std::bad_alloc();
+}
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, size_t) noexcept { std::free(ptr); }
+
+namespace GraphInf
+{
+
+    template <typename Graph>
+    static void runSweepBenchmark(benchmark::State &state, Graph &graph)
+    {
+        const size_t numSteps = 1000;
+        size_t allocations = 0;
+        for (auto _ : state)
+        {
+            size_t before = allocationCount;
+            benchmark::DoNotOptimize(graph.metropolisGraphSweep(numSteps));
+            allocations += allocationCount - before;
+        }
+        state.SetItemsProcessed(state.iterations() * numSteps);
+        state.counters["allocs_per_step"] = (double)allocations / (state.iterations() * numSteps);
+    }
+
+    static void BM_ER_metropolisGraphSweep(benchmark::State &state)
+    {
+        seed(1);
+        ErdosRenyiModel graph(state.range(0), 2.5 * state.range(0));
+        runSweepBenchmark(state, graph);
+    }
+    BENCHMARK(BM_ER_metropolisGraphSweep)->Arg(100)->Arg(1000);
+
+    static void BM_CM_metropolisGraphSweep(benchmark::State &state)
+    {
+        seed(1);
+        ConfigurationModelFamily graph(state.range(0), 2.5 * state.range(0));
+        runSweepBenchmark(state, graph);
+    }
+    BENCHMARK(BM_CM_metropolisGraphSweep)->Arg(100)->Arg(1000);
+
+}
@@ -0,0 +1,64 @@
+#include <vector>
+#include "benchmark/benchmark.h"
+
+#include "GraphInf/rng.h"
+#include "GraphInf/rv.hpp"
+#include "GraphInf/graph/sbm.h"
+
+namespace GraphInf
+{
+
+    /* Chain of nested variables shaped like RandomGraph -> LabelGraphPrior ->
+     * BlockPrior -> BlockCountPrior -> EdgeCountPrior, where each level goes
+     * through the recursion guard. Isolates the cost of the guard itself. */
+    class GuardedChain : public NestedRandomVariable
+    {
+        GuardedChain *m_child;
+        double m_value;
+
+    public:
+        GuardedChain(GuardedChain *child, double value) : m_child(child), m_value(value)
+        {
+            if (m_child)
+                m_child->isRoot(false);
+        }
+        const double getValue() const
+        {
+            return processRecursiveConstFunction<double>([&]()
+                                                         { return m_value + ((m_child) ? m_child->getValue() : 0); },
+                                                         0);
+        }
+        void computationFinished() const override
+        {
+            NestedRandomVariable::computationFinished();
+            if (m_child)
+                m_child->computationFinished();
+        }
+    };
+
+    static void BM_RecursionGuard_nestedChain(benchmark::State &state)
+    {
+        std::vector<GuardedChain *> chain = {nullptr};
+        for (int64_t i = 0; i < state.range(0); i++)
+            chain.push_back(new GuardedChain(chain.back(), i));
+        for (auto _ : state)
+            benchmark::DoNotOptimize(chain.back()->getValue());
+        for (auto level : chain)
+            delete level;
+    }
+    BENCHMARK(BM_RecursionGuard_nestedChain)->Arg(5);
+
+    static void BM_SBM_logJointRatioFromGraphMove(benchmark::State &state)
+    {
+        seed(1);
+        StochasticBlockModelFamily model(state.range(0), 2.5 * state.range(0), 5);
+        std::vector<GraphMove> moves;
+        for (size_t i = 0; i < 1000; i++)
+            moves.push_back(model.proposeGraphMove());
+        size_t i = 0;
+        for (auto _ : state)
+            benchmark::DoNotOptimize(model.getLogJointRatioFromGraphMove(moves[i++ % moves.size()]));
+    }
+    BENCHMARK(BM_SBM_logJointRatioFromGraphMove)->Arg(100)->Arg(1000);
+
+}
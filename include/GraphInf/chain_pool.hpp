@@ -0,0 +1,130 @@
+#ifndef GRAPH_INF_CHAIN_POOL_HPP
+#define GRAPH_INF_CHAIN_POOL_HPP
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "GraphInf/mcmc.h"
+#include "GraphInf/rng.h"
+#include "GraphInf/utility/parallel.hpp"
+
+namespace GraphInf
+{
+
+    struct ChainStatistics
+    {
+        size_t sweeps = 0;
+        double seconds = 0;
+
+        double getSweepsPerSecond() const { return (seconds > 0) ? sweeps / seconds : 0; }
+    };
+
+    /* Runs independent MCMC chains on a pool of worker threads.
+     *
+     * `Model` is any type exposing `metropolisGraphSweep(numSteps, betaPrior,
+     * betaLikelihood)` and `setRNG` (e.g. `RandomGraph` or `DataModel`). The
+     * chains are built serially by the factory, since model constructors may
+     * draw from the global generator, then chain `k` is given the stream
+     * `makeRNGStream(masterSeed, k)`. The factory must return a pointer that
+     * keeps alive everything the model refers to (e.g. the graph prior of a
+     * `DataModel`). */
+    template <typename Model>
+    class ChainPool
+    {
+    public:
+        typedef std::function<std::shared_ptr<Model>(size_t chainIndex)> ModelFactory;
+        typedef std::function<void(size_t chainIndex, size_t sweep, const Model &model, const MCMCSummary &summary)> SampleSink;
+
+    private:
+        std::vector<std::shared_ptr<Model>> m_chains;
+        std::vector<RNG> m_streams;
+        std::vector<SampleSink> m_sinks;
+        std::vector<MCMCSummary> m_summaries;
+        std::vector<ChainStatistics> m_statistics;
+        size_t m_threadCount;
+
+        void runChain(size_t chainIndex, size_t numSweeps, size_t numStepsPerSweep, double betaPrior, double betaLikelihood)
+        {
+            Model &model = *m_chains[chainIndex];
+            auto start = std::chrono::steady_clock::now();
+            for (size_t sweep = 0; sweep < numSweeps; sweep++)
+            {
+                auto summary = model.metropolisGraphSweep(numStepsPerSweep, betaPrior, betaLikelihood);
+                m_summaries[chainIndex].join(summary);
+                if (m_sinks[chainIndex])
+                    m_sinks[chainIndex](chainIndex, sweep, model, summary);
+            }
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            m_statistics[chainIndex].sweeps += numSweeps;
+            m_statistics[chainIndex].seconds += elapsed.count();
+        }
+
+    public:
+        ChainPool(const ModelFactory &factory, size_t chainCount, size_t masterSeed = getSeed(), size_t threadCount = 0) : m_streams(makeRNGStreams(masterSeed, chainCount)),
+                                                                                                                             m_sinks(chainCount),
+                                                                                                                             m_summaries(chainCount),
+                                                                                                                             m_statistics(chainCount)
+        {
+            if (chainCount == 0)
+                throw std::invalid_argument("ChainPool: `chainCount` must be positive.");
+            setThreadCount(threadCount);
+            for (size_t k = 0; k < chainCount; k++)
+            {
+                m_chains.push_back(factory(k));
+                if (not m_chains.back())
+                    throw std::invalid_argument("ChainPool: factory returned a null model for chain " + std::to_string(k) + ".");
+                m_chains.back()->setRNG(m_streams[k]);
+            }
+        }
+        // The chains point into `m_streams`, so the pool is not copyable.
+        ChainPool(const ChainPool &) = delete;
+        ChainPool &operator=(const ChainPool &) = delete;
+
+        const size_t getChainCount() const { return m_chains.size(); }
+        const size_t getThreadCount() const { return m_threadCount; }
+        void setThreadCount(size_t threadCount) { m_threadCount = resolveThreadCount(threadCount); }
+
+        Model &getChain(size_t chainIndex) { return *m_chains.at(chainIndex); }
+        const Model &getChain(size_t chainIndex) const { return *m_chains.at(chainIndex); }
+
+        /* Sinks are called from the worker running the chain, after every sweep. */
+        void setSink(size_t chainIndex, const SampleSink &sink) { m_sinks.at(chainIndex) = sink; }
+        void setSinks(const SampleSink &sink)
+        {
+            for (auto &s : m_sinks)
+                s = sink;
+        }
+
+        /* Runs `numSweeps` sweeps of `numStepsPerSweep` steps on every chain and
+         * returns the summaries of this run joined in chain order. */
+        const MCMCSummary run(size_t numSweeps, size_t numStepsPerSweep, double betaPrior = 1, double betaLikelihood = 1)
+        {
+            for (auto &summary : m_summaries)
+                summary = MCMCSummary();
+            parallelFor(m_chains.size(), m_threadCount, [&](size_t k)
+                        { runChain(k, numSweeps, numStepsPerSweep, betaPrior, betaLikelihood); });
+
+            MCMCSummary summary;
+            for (const auto &s : m_summaries)
+                summary.join(s);
+            return summary;
+        }
+
+        const std::vector<MCMCSummary> &getChainSummaries() const { return m_summaries; }
+        const std::vector<ChainStatistics> &getChainStatistics() const { return m_statistics; }
+        std::vector<double> getSweepsPerSecond() const
+        {
+            std::vector<double> throughput;
+            for (const auto &s : m_statistics)
+                throughput.push_back(s.getSweepsPerSecond());
+            return throughput;
+        }
+    };
+
+}
+
+#endif
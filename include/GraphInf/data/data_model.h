@@ -2,10 +2,12 @@
 #define GRAPH_INF_DATAMODEL_H
 
 #include <cmath>
+#include <memory>
 #include "GraphInf/rv.hpp"
 #include "GraphInf/graph/random_graph.hpp"
 #include "GraphInf/data/proposer.h"
 #include "GraphInf/mcmc.h"
+#include "GraphInf/utility/parallel.hpp"
 
 namespace GraphInf
 {
@@ -19,6 +21,11 @@ namespace GraphInf
         std::uniform_real_distribution<double> m_uniform;
         MultiParamProposer m_paramProposer;
         double m_graphRate = 1, m_graphPriorRate = 1, m_paramRate = 1;
+        size_t m_speculationWidth = 1;
+        LazyThreadPool m_threadPool;
+
+        const StepResult<GraphMove> metropolisGraphStepFromLikelihoodRatio(const GraphMove &move, double logLikelihoodRatio, double betaPrior);
+        const MCMCSummary speculativeGraphSweep(size_t nSteps, double betaPrior, double betaLikelihood);
 
     public:
         DataModel(RandomGraph &prior) : m_uniform(0, 1) { setGraphPrior(prior); }
@@ -49,6 +56,9 @@ namespace GraphInf
             checkConsistency();
 #endif
         }
+        /* Same thread safety as `RandomGraph`: the const log-probability and
+         * graph move log-ratio methods can be called from many threads at once
+         * on a model that is not modified meanwhile. */
         virtual const double getLogLikelihood() const = 0;
         const double getLogPrior() const
         {
@@ -79,20 +89,32 @@ namespace GraphInf
         }
         const double getLogAcceptanceProbFromGraphMove(const GraphMove &move, double betaPrior = 1, double betaLikelihood = 1) const;
         virtual const StepResult<GraphMove> metropolisGraphStep(const double betaPrior = 1, const double betaLikelihood = 1, bool debug = false);
+        /* Log joint ratios of `moves` from the current state, computed
+         * concurrently (see `setThreadCount`). */
+        const std::vector<double> getLogJointRatiosFromGraphMoves(const std::vector<GraphMove> &moves) const
+        {
+            std::vector<double> logJointRatios(moves.size());
+            m_threadPool.get().parallelFor(moves.size(), [&](size_t i)
+                                           { logJointRatios[i] = getLogJointRatioFromGraphMove(moves[i]); });
+            return logJointRatios;
+        }
         const StepResult<GraphMove> greedyGraphStep(int nCandidates = 1)
         {
+            std::vector<GraphMove> moves;
+            for (int i = 1; i < nCandidates; i++)
+                moves.push_back(m_graphPriorPtr->proposeGraphMove());
+            const auto logJointRatios = getLogJointRatiosFromGraphMoves(moves);
+
+            // The first best candidate wins, whatever the thread count.
             GraphMove bestMove = {};
             double bestLogJointRatio = 0;
             bool accepted = false;
-
-            for (int i = 1; i < nCandidates; i++)
+            for (size_t i = 0; i < moves.size(); i++)
             {
-                auto move = m_graphPriorPtr->proposeGraphMove();
-                auto logJointRatio = getLogJointRatioFromGraphMove(move);
-                if (logJointRatio > bestLogJointRatio)
+                if (logJointRatios[i] > bestLogJointRatio)
                 {
-                    bestMove = move;
-                    bestLogJointRatio = logJointRatio;
+                    bestMove = moves[i];
+                    bestLogJointRatio = logJointRatios[i];
                     accepted = true;
                 }
             }
@@ -117,7 +139,7 @@ namespace GraphInf
             if (acceptProb > 1.0)
                 acceptProb = 1.0;
             bool accepted = false;
-            if (m_uniform(rng) < acceptProb)
+            if (m_uniform(*m_rngPtr) < acceptProb)
             {
                 applyParamMove(move);
                 accepted = true;
@@ -146,6 +168,24 @@ namespace GraphInf
             return {bestMove, bestLogJointRatio, accepted};
         }
         const MCMCSummary metropolisGraphSweep(size_t nSteps, const double betaPrior = 1, const double betaLikelihood = 1, int debugFrequency = 0);
+
+        /* With a speculation width `K > 1`, `metropolisGraphSweep` draws K
+         * proposals at once and computes their likelihood ratios concurrently
+         * against the current state, then walks them in order as the sequential
+         * sweep would. The batch is discarded after any accepted move, so the
+         * chain has the same distribution as with `K = 1`. Requires a thread-safe
+         * `getLogLikelihoodRatioFromGraphMove` (true of the C++ models). */
+        void setSpeculationWidth(size_t width) { m_speculationWidth = std::max<size_t>(1, width); }
+        const size_t getSpeculationWidth() const { return m_speculationWidth; }
+        /* Threads used for concurrent evaluations by this model and its graph
+         * prior (0 means one per hardware thread). Models overriding the ratio
+         * methods from Python must keep a single thread. */
+        virtual void setThreadCount(size_t threadCount)
+        {
+            m_threadPool.setThreadCount(threadCount);
+            m_graphPriorPtr->setThreadCount(threadCount);
+        }
+        const size_t getThreadCount() const { return m_threadPool.getThreadCount(); }
         const MCMCSummary metropolisParamSweep(size_t nSteps, const double betaPrior = 1, const double betaLikelihood = 1);
         const MCMCSummary greedyGraphSweep(size_t nSteps, size_t nCandidates = 1)
         {
@@ -220,9 +260,17 @@ namespace GraphInf
 
         void computationFinished() const override
         {
-            m_isProcessed = false;
+            NestedRandomVariable::computationFinished();
             m_graphPriorPtr->computationFinished();
         }
+        /* Makes the data model, its param proposers and its graph prior draw from `gen`. */
+        void setRNG(RNG &gen) override
+        {
+            NestedRandomVariable::setRNG(gen);
+            m_paramProposer.setRNG(gen);
+            if (m_graphPriorPtr)
+                m_graphPriorPtr->setRNG(gen);
+        }
         void checkSelfSafety() const override
         {
             if (m_graphPriorPtr == nullptr)
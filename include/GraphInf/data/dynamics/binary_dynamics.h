@@ -6,6 +6,7 @@
 
 #include "GraphInf/graph/random_graph.hpp"
 #include "GraphInf/data/dynamics/dynamics.h"
+#include "GraphInf/data/dynamics/log_transition_kernels.h"
 #include "GraphInf/types.h"
 
 namespace GraphInf
@@ -17,8 +18,35 @@ namespace GraphInf
         double m_autoActivationProb;
         double m_autoDeactivationProb;
         double MIN_AUTO_PROB = 0, MAX_AUTO_PROB = 1;
+        /* Log transition probabilities indexed by the numbers of inactive and
+         * active neighbours, then by the previous and next states. Counts
+         * past the table go through getTransitionProb. */
+        std::vector<double> m_logTransitionTable;
+        size_t m_tableInactiveSize = 0, m_tableActiveSize = 0;
+        bool m_tableDependsOnInactive = true;
+        static const size_t MAX_TABLE_SIZE = 1 << 18;
+
+        void computeLogTransitionTable();
+
+    protected:
+        /* Whether the transition probabilities depend on the number of
+         * inactive neighbours, and not only on the number of active ones. The
+         * table of the latter has one row per active count. */
+        virtual const bool dependsOnInactiveNeighbors() const { return true; }
+        /* Sums the tabulated log-probabilities with the SIMD kernels when the
+         * time series are contiguous (vertex-major layout, or packed). */
+        using Dynamics::computeVertexLogLikelihood;
+        const double computeVertexLogLikelihood(BaseGraph::VertexIndex vertex, const GraphMove &move, size_t first, size_t length) const override;
 
     public:
+        /* Whether the sequences are stored one bit per (vertex, time) cell
+         * instead of one int, without neighbour counts: these are counted
+         * from the packed past states, with one popcount per word spanned by
+         * the neighbours of a vertex, when a vertex is evaluated. The
+         * sequences take about 64 times less memory, for evaluations that
+         * grow with the degree. */
+        using Dynamics::setStatePacking;
+
         explicit BinaryDynamics(
             RandomGraph &randomGraph,
             size_t numSteps,
@@ -34,14 +62,45 @@ namespace GraphInf
         }
         const double getTransitionProb(
             const VertexState &prevVertexState, const VertexState &nextVertexState, const VertexNeighborhoodState &neighborhoodState) const override;
+        const VertexState sampleNextState(
+            const VertexState &prevVertexState, const VertexNeighborhoodState &neighborhoodState, double uniform) const override
+        {
+            return (uniform < getTransitionProb(prevVertexState, 0, neighborhoodState)) ? 0 : 1;
+        }
+        const double getLogTransitionProb(
+            const VertexState &prevVertexState, const VertexState &nextVertexState, const VertexNeighborhoodState &neighborhoodState) const override
+        {
+            const size_t inactive = m_tableDependsOnInactive ? neighborhoodState[0] : 0, active = neighborhoodState[1];
+            if (inactive < m_tableInactiveSize and active < m_tableActiveSize)
+                return m_logTransitionTable[4 * (inactive * m_tableActiveSize + active) + 2 * prevVertexState + nextVertexState];
+            return Dynamics::getLogTransitionProb(prevVertexState, nextVertexState, neighborhoodState);
+        }
+        void computeLogLikelihoodCache() override
+        {
+            computeLogTransitionTable();
+            Dynamics::computeLogLikelihoodCache();
+        }
+        void updateLogLikelihoodCacheFromTransitionCounts() override
+        {
+            computeLogTransitionTable();
+            Dynamics::updateLogLikelihoodCacheFromTransitionCounts();
+        }
 
         const State getRandomState(int initialActive) const;
         const State getRandomState() const override { return getRandomState(-1); }
         virtual const double getActivationProb(const VertexNeighborhoodState &neighborState) const = 0;
         virtual const double getDeactivationProb(const VertexNeighborhoodState &neighborState) const = 0;
 
-        void setAutoActivationProb(double autoActivationProb) { m_autoActivationProb = autoActivationProb; }
-        void setAutoDeactivationProb(double autoDeactivationProb) { m_autoDeactivationProb = autoDeactivationProb; }
+        void setAutoActivationProb(double autoActivationProb)
+        {
+            m_autoActivationProb = autoActivationProb;
+            computeLogLikelihoodCache();
+        }
+        void setAutoDeactivationProb(double autoDeactivationProb)
+        {
+            m_autoDeactivationProb = autoDeactivationProb;
+            computeLogLikelihoodCache();
+        }
         const double getAutoActivationProb() const { return m_autoActivationProb; }
         const double getAutoDeactivationProb() const { return m_autoDeactivationProb; }
         void applyParamMove(const ParamMove &move) override
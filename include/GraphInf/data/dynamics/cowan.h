@@ -49,6 +49,9 @@ namespace GraphInf
             m_paramProposer.insertGaussianProposer("eta", 1.0, 0.0, muStddev);
         }
 
+        // Only the active neighbours matter.
+        const bool dependsOnInactiveNeighbors() const override { return false; }
+
         const double getActivationProb(const VertexNeighborhoodState &vertexNeighborState) const override
         {
             return sigmoid(m_a * (getNu() * vertexNeighborState[1] - m_mu));
@@ -58,13 +61,29 @@ namespace GraphInf
             return m_eta;
         }
         const double getA() const { return m_a; }
-        void setA(double a) { m_a = a; }
+        void setA(double a)
+        {
+            m_a = a;
+            computeLogLikelihoodCache();
+        }
         const double getNu() const { return m_nu; }
-        void setNu(double nu) { m_nu = nu; }
+        void setNu(double nu)
+        {
+            m_nu = nu;
+            computeLogLikelihoodCache();
+        }
         const double getMu() const { return m_mu; }
-        void setMu(double mu) { m_mu = mu; }
+        void setMu(double mu)
+        {
+            m_mu = mu;
+            computeLogLikelihoodCache();
+        }
         const double getEta() const { return m_eta; }
-        void setEta(double eta) { m_eta = eta; }
+        void setEta(double eta)
+        {
+            m_eta = eta;
+            computeLogLikelihoodCache();
+        }
 
         void applyParamMove(const ParamMove &move) override
         {
@@ -22,7 +22,11 @@ namespace GraphInf
             return 1 - getActivationProb(vertexNeighborState);
         }
         const double getC() const { return m_C; }
-        void setC(double C) { m_C = C; }
+        void setC(double C)
+        {
+            m_C = C;
+            computeLogLikelihoodCache();
+        }
     };
 
 } // namespace GraphInf
@@ -12,11 +12,16 @@
 #include "GraphInf/exceptions.h"
 #include "GraphInf/graph/random_graph.hpp"
 #include "GraphInf/utility/functions.h"
+#include "GraphInf/utility/philox.h"
+#include "GraphInf/utility/sum_tree.hpp"
 #include "GraphInf/rng.h"
 #include "GraphInf/generators.h"
 
 #include "GraphInf/data/data_model.h"
 #include "GraphInf/data/types.h"
+#include "GraphInf/data/dynamics/sequence_arena.hpp"
+#include "GraphInf/data/dynamics/mapped_state_file.h"
+#include "GraphInf/data/dynamics/log_transition_kernels.h"
 
 namespace GraphInf
 {
@@ -24,34 +29,193 @@ namespace GraphInf
     class Dynamics : public DataModel
     {
     protected:
+        /* The full passes over the vertices (neighbour counts, likelihood)
+         * run on the thread pool of the model in blocks of this many
+         * vertices, whose sums are added in order. */
+        static const size_t VERTEX_BLOCK_SIZE = 64;
         size_t m_numStates;
         size_t m_length;
         std::vector<VertexState> m_state;
         Matrix<VertexState> m_neighborsState;
         bool m_acceptSelfLoops = false;
-        Matrix<VertexState> m_pastStateSequence;
-        Matrix<VertexState> m_futureStateSequence;
-        Matrix<std::vector<VertexState>> m_neighborsPastStateSequence;
+        SequenceArena<VertexState> m_pastStateSequence;
+        SequenceArena<VertexState> m_futureStateSequence;
+        SequenceArena<VertexState> m_neighborsPastStateSequence;
+        /* Whether the sequences are one trajectory of T + 1 steps, held once
+         * in the past sequence: the future state at t is then the past state
+         * at t + 1, and the future sequence stays empty. Arbitrary (past,
+         * future) pairs are held in both. */
+        bool m_isTrajectory = false;
+        /* Whether m_neighborsPastStateSequence is kept. Otherwise, the
+         * neighbour counts of a vertex are counted from its neighbours' past
+         * states each time it is evaluated. */
+        bool m_cacheNeighborsPastStates = true;
+        const bool storesNeighborsPastStates() const { return m_cacheNeighborsPastStates and not m_packStates; }
+        bool m_cacheLogLikelihood = true;
+        std::vector<double> m_vertexLogLikelihoods;
+        /* The value of a vertex is only up to date when its generation is
+         * m_logLikelihoodGeneration. Parameter moves start a new generation:
+         * const reads recompute stale values without storing them, so that
+         * they stay safe across threads, and applyGraphMoveToSelf stores the
+         * values of the vertices it moves. */
+        std::vector<size_t> m_vertexLogLikelihoodGenerations;
+        size_t m_logLikelihoodGeneration = 0;
+        const bool isVertexLogLikelihoodStale(BaseGraph::VertexIndex vertex) const { return m_vertexLogLikelihoodGenerations[vertex] != m_logLikelihoodGeneration; }
+        double m_logLikelihood = 0;
+        /* Number of (vertex, time) cells per transition, keyed by
+         * [past state, future state, neighbour counts...]. The likelihood only
+         * depends on the sequences through it, so parameter-move ratios are
+         * sums over its distinct entries. Kept along with the cache. */
+        TransitionCounts m_transitionCounts;
+        bool m_holdLogLikelihoodCache = false;
+        // Transitions evicted since the likelihood cache was last recomputed, see evictFrontSteps.
+        size_t m_numEvictedSinceRefresh = 0;
+        /* With state packing, binary sequences are held one bit per cell in
+         * place of the past and future arenas, and the neighbour counts are
+         * not stored but counted from the packed past states when needed. */
+        bool m_packStates = false;
+        PackedStateSequence m_packedPastStates, m_packedFutureStates;
+        static_assert(VERTEX_BLOCK_SIZE % PackedStateSequence::WORD_SIZE == 0, "Vertex blocks must not share packed words.");
+
+        /* Past and future states and neighbour counts of one vertex, the
+         * ones of time t at t * stride and t * countStride. */
+        struct VertexSequences
+        {
+            const VertexState *pastStates, *futureStates, *neighborCounts;
+            size_t stride, countStride;
+        };
+        /* Reads the sequences of `vertex` from time `first` on in place from the arenas or, when
+         * packed, unpacks them into thread-local buffers, contiguous and
+         * valid until the next call on the thread. */
+        const VertexSequences getVertexSequences(BaseGraph::VertexIndex vertex, size_t first, size_t length) const;
+        const VertexSequences getVertexSequences(BaseGraph::VertexIndex vertex) const { return getVertexSequences(vertex, 0, m_length); }
+        /* Changes of the neighbour counts of `vertex` under the edges of
+         * `move`, with contiguous past states of the other endpoints (copied
+         * to thread-local buffers unless the arena is vertex-major). */
+        const SmallVector<NeighborShift, 4> getNeighborShifts(BaseGraph::VertexIndex vertex, const GraphMove &move, size_t first, size_t length) const;
+        const SmallVector<NeighborShift, 4> getNeighborShifts(BaseGraph::VertexIndex vertex, const GraphMove &move) const { return getNeighborShifts(vertex, move, 0, m_length); }
+        // Number of times `neighbor` counts among the neighbours of `vertex` (0 for ignored self-loops).
+        const size_t getNeighborWeight(BaseGraph::VertexIndex vertex, BaseGraph::VertexIndex neighbor) const
+        {
+            if (vertex == neighbor)
+                return m_acceptSelfLoops ? 2 * DataModel::getGraph().getEdgeMultiplicity(vertex, neighbor) : 0;
+            return DataModel::getGraph().getEdgeMultiplicity(vertex, neighbor);
+        }
+        // Neighbours of `vertex` grouped by packed word and multiplicity.
+        void getNeighborMasks(BaseGraph::VertexIndex vertex, std::vector<PackedVertexMask> &masks) const;
+        const bool hasStateSequences() const
+        {
+            const size_t N = DataModel::getSize();
+            if (m_packStates)
+                return m_packedPastStates.size() == N and (m_isTrajectory or m_packedFutureStates.size() == N);
+            return m_pastStateSequence.size() == N and (m_isTrajectory or m_futureStateSequence.size() == N) and (not storesNeighborsPastStates() or m_neighborsPastStateSequence.size() == N);
+        }
+        /* Resizes the sequences to `size` x `length` transitions, filled with
+         * zeros, as one trajectory or as pairs. */
+        void resizeStateSequences(size_t size, size_t length, bool isTrajectory);
+        void setPastState(BaseGraph::VertexIndex vertex, size_t t, VertexState state)
+        {
+            if (m_packStates)
+                m_packedPastStates.set(vertex, t, state);
+            else
+                *m_pastStateSequence.at(vertex, t) = state;
+        }
+        void setFutureState(BaseGraph::VertexIndex vertex, size_t t, VertexState state)
+        {
+            if (m_isTrajectory)
+                setPastState(vertex, t + 1, state);
+            else if (m_packStates)
+                m_packedFutureStates.set(vertex, t, state);
+            else
+                *m_futureStateSequence.at(vertex, t) = state;
+        }
+        /* Switches between the arenas and bit-packed sequences, which only
+         * hold binary states. Exposed by BinaryDynamics. */
+        void setStatePacking(bool pack);
 
         void updateNeighborsStateInPlace(
             BaseGraph::VertexIndex vertexIdx,
             VertexState prevVertexState,
             VertexState newVertexState,
             NeighborsState &neighborsState) const;
-        void updateNeighborsStateFromEdgeMove(
-            BaseGraph::Edge,
-            int direction,
-            std::map<BaseGraph::VertexIndex, VertexNeighborhoodStateSequence> &,
-            std::map<BaseGraph::VertexIndex, VertexNeighborhoodStateSequence> &) const;
+        // Throws if the move removes an edge absent from the graph.
+        void checkGraphMove(const GraphMove &move) const;
+        // Endpoints of the edges of `move` whose neighbour counts change.
+        const SmallVector<BaseGraph::VertexIndex, 4> getVerticesAffectedByGraphMove(const GraphMove &move) const;
+        /* Log-likelihood of the time series of `vertex` once the edges of
+         * `move` are added to or removed from its neighbour counts. The counts
+         * are shifted step by step in a scratch buffer, without allocating.
+         * Restricted to the transitions first, ..., first + length - 1. */
+        virtual const double computeVertexLogLikelihood(BaseGraph::VertexIndex vertex, const GraphMove &move, size_t first, size_t length) const;
+        const double computeVertexLogLikelihood(BaseGraph::VertexIndex vertex, const GraphMove &move) const { return computeVertexLogLikelihood(vertex, move, 0, m_length); }
+        const double computeVertexLogLikelihood(BaseGraph::VertexIndex vertex) const { return computeVertexLogLikelihood(vertex, {}); }
+        const double getVertexLogLikelihood(BaseGraph::VertexIndex vertex) const
+        {
+            if (not isLogLikelihoodCached() or isVertexLogLikelihoodStale(vertex))
+                return computeVertexLogLikelihood(vertex);
+            return m_vertexLogLikelihoods[vertex];
+        }
+        const bool isLogLikelihoodCached() const { return m_cacheLogLikelihood and m_vertexLogLikelihoods.size() == DataModel::getSize(); }
+        /* Recomputes the log-likelihood of every vertex. Called whenever the
+         * sequences or the transition probabilities change. */
+        virtual void computeLogLikelihoodCache();
+        /* After a parameter move: sets the log-likelihood from the transition
+         * counts and leaves the value of each vertex stale until it is read. */
+        virtual void updateLogLikelihoodCacheFromTransitionCounts();
+        const TransitionCounts computeTransitionCounts() const;
+        /* Adds (counter=1) or removes (counter=-1) the transitions of `vertex`,
+         * with its neighbour counts once `move` is applied, over the
+         * transitions first, ..., first + length - 1. */
+        void updateTransitionCounts(BaseGraph::VertexIndex vertex, int counter, TransitionCounts &transitionCounts, const GraphMove &move, size_t first, size_t length) const;
+        void updateTransitionCounts(BaseGraph::VertexIndex vertex, int counter, TransitionCounts &transitionCounts, const GraphMove &move = {}) const
+        {
+            updateTransitionCounts(vertex, counter, transitionCounts, move, 0, m_length);
+        }
+        const double getLogLikelihoodFromTransitionCounts() const;
+
+        /* Synchronous update of every vertex, the one of `vertex` drawn from
+         * the Philox counter (step, vertex) under `key`. The vertices are
+         * split over the thread pool and the result does not depend on the
+         * thread count. */
+        void syncUpdateStateFromKey(uint64_t key, size_t step);
+        // Rate at which `vertex` leaves its current state in continuous time.
+        const double getLeaveRate(BaseGraph::VertexIndex vertex) const;
+        /* State entered by `vertex` when it leaves its current one, chosen in
+         * proportion to the transition probabilities at `uniform`. */
+        const VertexState sampleStateAfterLeaving(BaseGraph::VertexIndex vertex, double uniform) const;
+
+        void applyEdgeMoveToNeighborsPastStates(const BaseGraph::Edge &edge, int counter);
+        // Neighbour counts of the first `length` steps of `stateSequence`.
+        void computeNeighborsStateSequence(
+            const SequenceArena<VertexState> &stateSequence,
+            size_t length,
+            SequenceArena<VertexState> &neighborsStateSequence) const;
+        // Adds the neighbour counts of steps first, ..., first + length - 1 to the (sized) `neighborsStateSequence`.
+        void computeNeighborsStateSequence(
+            const SequenceArena<VertexState> &stateSequence,
+            size_t first,
+            size_t length,
+            SequenceArena<VertexState> &neighborsStateSequence) const;
+        /* Adds (counter=1) or removes (counter=-1) the transitions first,
+         * ..., first + length - 1 of every vertex from the likelihood cache
+         * and the transition counts. */
+        void updateLogLikelihoodCache(int counter, size_t first, size_t length);
+        /* Drops the first `count` transitions and their terms from the
+         * cache, which is recomputed after every full window turnover so
+         * that rounding errors do not build up over a stream. */
+        void evictFrontSteps(size_t count);
 
         void checkConsistencyOfNeighborsState() const;
         void checkConsistencyOfNeighborsPastStateSequence() const;
+        void checkConsistencyOfLogLikelihoodCache() const;
+        void checkConsistencyOfTransitionCounts() const;
         void computeConsistentState() override;
 
     public:
         explicit Dynamics(RandomGraph &graphPrior, size_t numStates, size_t length) : DataModel(graphPrior),
                                                                                       m_numStates(numStates),
-                                                                                      m_length(length) {}
+                                                                                      m_length(length),
+                                                                                      m_neighborsPastStateSequence(numStates) {}
 
         const std::vector<VertexState> &getState() const { return m_state; }
         void setCurrentState(std::vector<VertexState> &state)
@@ -62,35 +226,93 @@ namespace GraphInf
             checkSelfConsistency();
 #endif
         }
-        void setState(Matrix<VertexState> states)
+        // Sets a trajectory given as `states[vertex][t]`, with t = 0, ..., T.
+        void setState(const Matrix<VertexState> &states);
+        /* Sets pairs of consecutive states given as `past[vertex][t]` and
+         * `future[vertex][t]`, held as one trajectory when every future state
+         * is the next past one. */
+        void setState(const Matrix<VertexState> &past, const Matrix<VertexState> &future);
+        /* Sets a trajectory read in place from the int32 states of a mapped
+         * `.npy` or raw file (see MappedStateFile), of shape (N, T + 1) with
+         * VertexMajor or (T + 1, N) with TimeMajor, so that recordings
+         * larger than the memory are paged in as needed. With VertexMajor,
+         * each evaluation of a vertex streams over its contiguous time
+         * series. The file is copied in memory if packed, relaid out or
+         * written to; disable the neighbour-count storage to keep the
+         * rest of the footprint O(N). The states are checked to lie in
+         * [0, number of states) in one pass over the file. */
+        void setStateFromFile(const std::string &path, SequenceLayout layout = SequenceLayout::VertexMajor);
+        /* Extends the trajectory with the states `states[vertex][k]` of the
+         * next steps, or the transitions with pairs `past[vertex][k]` and
+         * `future[vertex][k]` (held as pairs from then on unless they
+         * continue the trajectory). Only the new steps are counted in the
+         * neighbour counts and likelihood cache. With a nonzero `maxLength`,
+         * the oldest transitions beyond it are then evicted likewise, for
+         * sliding windows; time-major and packed sequences do both in
+         * amortized O(N x changed steps), vertex-major ones in O(N x T). */
+        void appendStates(const Matrix<VertexState> &states, size_t maxLength = 0);
+        void appendStates(const Matrix<VertexState> &past, const Matrix<VertexState> &future, size_t maxLength = 0);
+        bool acceptSelfLoops() { return m_acceptSelfLoops; }
+        void acceptSelfLoops(bool condition) { m_acceptSelfLoops = condition; }
+        const Matrix<VertexState> &getNeighborsState() const { return m_neighborsState; }
+        const SequenceView<VertexState> getPastStates() const
+        {
+            if (m_packStates)
+                return SequenceView<VertexState>(m_packedPastStates, 0, m_isTrajectory ? m_length : m_packedPastStates.getLength());
+            return SequenceView<VertexState>(m_pastStateSequence, 0, m_isTrajectory ? m_length : m_pastStateSequence.getLength());
+        }
+        const SequenceView<VertexState> getFutureStates() const
         {
-            m_pastStateSequence.clear();
-            m_futureStateSequence.clear();
-
-            for (size_t t = 0; t < states.size() - 1; t++)
-            {
-                m_pastStateSequence.push_back(states[t]);
-                m_futureStateSequence.push_back(states[t + 1]);
-            }
-            computeConsistentState();
+            if (m_isTrajectory)
+                return m_packStates ? SequenceView<VertexState>(m_packedPastStates, 1, m_length) : SequenceView<VertexState>(m_pastStateSequence, 1, m_length);
+            return m_packStates ? SequenceView<VertexState>(m_packedFutureStates) : SequenceView<VertexState>(m_futureStateSequence);
         }
-        void setState(Matrix<VertexState> past, Matrix<VertexState> future)
+        // Empty when the counts are not stored, see computeNeighborsStateSequence.
+        const CellSequenceView<VertexState> getNeighborsPastStates() const { return m_neighborsPastStateSequence; }
+        const bool getStatePacking() const { return m_packStates; }
+        /* Whether the neighbour counts of the past states (N x T x number of
+         * states ints, often the largest allocation) are stored. Without
+         * them, the likelihood of a vertex counts its neighbours' states over
+         * its adjacency list every time, in O(T * degree) instead of O(T).
+         * Packed states never store them. */
+        void setNeighborsPastStateCaching(bool cache);
+        const bool getNeighborsPastStateCaching() const { return m_cacheNeighborsPastStates; }
+        const SequenceLayout getSequenceLayout() const { return m_pastStateSequence.getLayout(); }
+        void setSequenceLayout(SequenceLayout layout)
         {
-            m_pastStateSequence = past;
-            m_futureStateSequence = future;
-            computeConsistentState();
+            m_pastStateSequence.setLayout(layout);
+            m_futureStateSequence.setLayout(layout);
+            m_neighborsPastStateSequence.setLayout(layout);
         }
-        bool acceptSelfLoops() { return m_acceptSelfLoops; }
-        void acceptSelfLoops(bool condition) { m_acceptSelfLoops = condition; }
-        const Matrix<VertexState> &getNeighborsState() const { return m_neighborsState; }
-        const Matrix<VertexState> &getPastStates() const { return m_pastStateSequence; }
-        const Matrix<VertexState> &getFutureStates() const { return m_futureStateSequence; }
-        const Matrix<std::vector<VertexState>> &getNeighborsPastStates() const { return m_neighborsPastStateSequence; }
+        /* Whether the log-likelihood of each vertex's time series is kept
+         * between moves, so that graph-move ratios only evaluate the proposed
+         * side and getLogLikelihood is a lookup. The cache is refreshed by
+         * the state setters, applyParamMove (lazily, vertex by vertex) and
+         * the parameter setters of the dynamics of this library; subclasses
+         * whose transition probabilities change otherwise must call
+         * computeLogLikelihoodCache or disable it. Python subclasses disable
+         * it. */
+        void setLogLikelihoodCaching(bool cache)
+        {
+            m_cacheLogLikelihood = cache;
+            m_transitionCounts = computeTransitionCounts();
+            computeLogLikelihoodCache();
+        }
+        const bool getLogLikelihoodCaching() const { return m_cacheLogLikelihood; }
+        const TransitionCounts &getTransitionCounts() const { return m_transitionCounts; }
         const size_t getNumStates() const { return m_numStates; }
         const size_t getLength() const { return m_length; }
         void setLength(size_t length) { m_length = length; }
 
         void sampleState(const std::vector<VertexState> &initialState = {}, bool asyncMode = false, size_t initialBurn = 0);
+        /* Samples the sequences from the continuous-time counterpart of the
+         * dynamics, read at unit intervals after `initialBurn`. A vertex
+         * leaves its state at rate -log(p), p being its probability of
+         * staying for one step, so that isolated vertices behave as in
+         * discrete time. Events are drawn with Gillespie's direct method from
+         * a sum tree of the rates, updated for the vertex that changed and
+         * its neighbours only, so that quiescent vertices cost nothing. */
+        void sampleStateFromEvents(const std::vector<VertexState> &initialState = {}, double initialBurn = 0);
         void sample(const std::vector<VertexState> &initialState = {}, bool asyncMode = false, size_t initialBurn = 0)
         {
             DataModel::m_graphPriorPtr->sample();
@@ -104,16 +326,30 @@ namespace GraphInf
         const NeighborsState computeNeighborsState(const State &state) const;
         const NeighborsStateSequence computeNeighborsStateSequence(const StateSequence &stateSequence) const;
 
-        void syncUpdateState();
+        void syncUpdateState() { syncUpdateStateFromKey((*m_rngPtr)(), 0); }
         void asyncUpdateState(size_t num_updates);
 
         const double getLogLikelihood() const override;
         virtual const double getTransitionProb(
             const VertexState &prevVertexState, const VertexState &nextVertexState, const VertexNeighborhoodState &neighborhoodState) const = 0;
 
+        /* Log-probability of a transition given the neighbour counts, used by
+         * the likelihood and its ratios. Subclasses that tabulate it override
+         * it to skip getTransitionProb. */
+        virtual const double getLogTransitionProb(
+            const VertexState &prevVertexState, const VertexState &nextVertexState, const VertexNeighborhoodState &neighborhoodState) const
+        {
+            return log(getTransitionProb(prevVertexState, nextVertexState, neighborhoodState));
+        }
+
         const std::vector<double> getTransitionProbs(
             const VertexState &prevVertexState,
             const VertexNeighborhoodState &neighborhoodState) const;
+        /* Next state of a vertex for a `uniform` draw in [0, 1), obtained by
+         * inverting the cumulative transition probabilities in a scratch
+         * buffer. Binary dynamics compare it with one probability instead. */
+        virtual const VertexState sampleNextState(
+            const VertexState &prevVertexState, const VertexNeighborhoodState &neighborhoodState, double uniform) const;
         const std::vector<double> getTransitionProbs(const BaseGraph::VertexIndex vertex) const
         {
             return getTransitionProbs(m_state[vertex], m_neighborsState[vertex]);
@@ -122,6 +358,18 @@ namespace GraphInf
 
         const double getLogLikelihoodRatioFromGraphMove(const GraphMove &move) const override;
         void applyGraphMoveToSelf(const GraphMove &move) override;
+        void applyParamMove(const ParamMove &move) override
+        {
+            // Greedy steps apply an empty move when no candidate wins.
+            if (move.key.empty() or move.value == 0)
+                return;
+            DataModel::applyParamMove(move);
+            if (not m_holdLogLikelihoodCache)
+                updateLogLikelihoodCacheFromTransitionCounts();
+        }
+        /* Sums the log-probabilities of the distinct transitions before and
+         * after the move, weighted by their counts, when the cache is on. */
+        const double getLogLikelihoodRatioFromParaMove(const ParamMove &move) override;
         virtual bool isValidParamMove(const ParamMove &move) const override
         {
             return DataModel::isValidParamMove(move);
@@ -131,7 +379,9 @@ namespace GraphInf
 
         bool isSafe() const override
         {
-            return DataModel::isSafe() and (m_state.size() != 0) and (m_pastStateSequence.size() != 0) and (m_futureStateSequence.size() != 0) and (m_neighborsPastStateSequence.size() != 0);
+            if (m_packStates)
+                return DataModel::isSafe() and (m_state.size() != 0) and (m_packedPastStates.size() != 0) and (m_isTrajectory or m_packedFutureStates.size() != 0);
+            return DataModel::isSafe() and (m_state.size() != 0) and (m_pastStateSequence.size() != 0) and (m_isTrajectory or m_futureStateSequence.size() != 0) and (not storesNeighborsPastStates() or m_neighborsPastStateSequence.size() != 0);
         }
     };
 
@@ -45,7 +45,11 @@ namespace GraphInf
             return p;
         }
         const double getCoupling() const { return m_coupling; }
-        void setCoupling(double coupling) { m_coupling = coupling; }
+        void setCoupling(double coupling)
+        {
+            m_coupling = coupling;
+            computeLogLikelihoodCache();
+        }
         void applyParamMove(const ParamMove &move) override
         {
             if (move.key == "coupling")
@@ -0,0 +1,73 @@
+#ifndef GRAPH_INF_LOG_TRANSITION_KERNELS_H
+#define GRAPH_INF_LOG_TRANSITION_KERNELS_H
+
+#include <cstddef>
+
+#include "GraphInf/data/types.h"
+#include "GraphInf/data/dynamics/sequence_arena.hpp"
+
+namespace GraphInf
+{
+
+    enum class SimdLevel : unsigned char
+    {
+        Scalar,
+        SSE4,
+        AVX2
+    };
+
+    // Best instruction set of the running processor supported by the kernels.
+    SimdLevel getSupportedSimdLevel();
+
+    /* Log transition probabilities of a binary dynamics, stored at
+     * 4 * (inactive * inactiveStride + active) + 2 * prev + next for
+     * inactive < inactiveSize and active < activeSize. */
+    struct LogTransitionTable
+    {
+        const double *values;
+        int inactiveStride, inactiveSize, activeSize;
+    };
+
+    /* Change of the neighbour counts of a vertex due to one edge of a graph
+     * move: at each time step, the count of the past state of the other
+     * endpoint, `states[t]`, changes by `counter`. */
+    struct NeighborShift
+    {
+        const VertexState *states;
+        int counter;
+    };
+
+    /* Sums the log transition probabilities of one vertex over `length`
+     * time steps, given its contiguous past and future states and its
+     * interleaved (inactive, active) neighbour counts, shifted by `shifts`.
+     * Returns false, leaving `sum` unspecified, if a count falls outside the
+     * table. The terms are added in the same order at every SimdLevel, so
+     * the sum does not depend on the kernel that computes it. */
+    bool sumLogTransitions(
+        const LogTransitionTable &table,
+        const VertexState *pastStates,
+        const VertexState *futureStates,
+        const VertexState *neighborCounts,
+        const NeighborShift *shifts,
+        size_t numShifts,
+        size_t length,
+        double &sum,
+        SimdLevel level = getSupportedSimdLevel());
+
+    /* Fills the interleaved (inactive, active) neighbour counts of one vertex
+     * over the time steps first, ..., first + length - 1 of `packedStates`,
+     * from its neighbours
+     * `masks`, weighted `numNeighbors` times in total. Uses the popcount
+     * instruction when the processor has one. */
+    void countPackedNeighborStates(
+        const PackedStateSequence &packedStates,
+        const PackedVertexMask *masks,
+        size_t numMasks,
+        int numNeighbors,
+        size_t first,
+        size_t length,
+        VertexState *neighborCounts);
+
+}
+
+#endif
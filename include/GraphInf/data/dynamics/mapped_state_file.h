@@ -0,0 +1,48 @@
+#ifndef GRAPH_INF_MAPPED_STATE_FILE_H
+#define GRAPH_INF_MAPPED_STATE_FILE_H
+
+#include <string>
+#include <vector>
+
+#include "GraphInf/data/types.h"
+
+namespace GraphInf
+{
+
+    /* Read-only memory mapping of a file of states, stored as native 32-bit
+     * integers: either a C-ordered `.npy` array of dtype int32, whose shape
+     * is read from its header, or a raw file of such integers, of shape
+     * {number of values}. Pages are only read from disk when accessed and
+     * can be evicted by the system, so that files larger than the memory can
+     * be used. */
+    class MappedStateFile
+    {
+        std::string m_path;
+        void *m_address = nullptr;
+        size_t m_mappingSize = 0;
+        const VertexState *m_states = nullptr;
+        std::vector<size_t> m_shape;
+
+        void parseNpyHeader(const char *bytes, size_t numBytes, size_t &dataOffset);
+
+    public:
+        explicit MappedStateFile(const std::string &path);
+        ~MappedStateFile();
+        MappedStateFile(const MappedStateFile &) = delete;
+        MappedStateFile &operator=(const MappedStateFile &) = delete;
+
+        const std::string &getPath() const { return m_path; }
+        const std::vector<size_t> &getShape() const { return m_shape; }
+        const size_t size() const
+        {
+            size_t numValues = 1;
+            for (auto dim : m_shape)
+                numValues *= dim;
+            return numValues;
+        }
+        const VertexState *data() const { return m_states; }
+    };
+
+} // namespace GraphInf
+
+#endif
@@ -0,0 +1,446 @@
+#ifndef GRAPH_INF_SEQUENCE_ARENA_HPP
+#define GRAPH_INF_SEQUENCE_ARENA_HPP
+
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+#include "GraphInf/types.h"
+
+namespace GraphInf
+{
+
+    /* Order of the (vertex, time) cells of a SequenceArena. With VertexMajor,
+     * the time series of each vertex is contiguous; with TimeMajor, the cells
+     * of all the vertices at one time step are. */
+    enum class SequenceLayout : unsigned char
+    {
+        VertexMajor,
+        TimeMajor
+    };
+
+    /* N x T sequence holding `width` consecutive values per (vertex, time)
+     * cell (e.g. one state, or the neighbour count of each state), stored in a
+     * single flat block. The block can also be external read-only memory
+     * (e.g. a mapped file), copied into an owned block on the first write. */
+    template <typename T>
+    class SequenceArena
+    {
+        size_t m_size = 0, m_length = 0, m_width;
+        SequenceLayout m_layout;
+        std::vector<T> m_data;
+        /* Start of the cells in m_data: time-major steps evicted from the
+         * front are skipped, and only dropped once they outnumber the live
+         * cells. */
+        size_t m_offset = 0;
+        const T *m_external = nullptr;
+        std::shared_ptr<const void> m_externalOwner;
+
+        void detach()
+        {
+            if (not m_external)
+                return;
+            m_data.assign(m_external, m_external + m_size * m_length * m_width);
+            m_offset = 0;
+            m_external = nullptr;
+            m_externalOwner.reset();
+        }
+
+    public:
+        explicit SequenceArena(size_t width = 1, SequenceLayout layout = SequenceLayout::VertexMajor) : m_width(width), m_layout(layout) {}
+
+        const size_t size() const { return m_size; }
+        const size_t getLength() const { return m_length; }
+        const size_t getWidth() const { return m_width; }
+        const SequenceLayout getLayout() const { return m_layout; }
+
+        // Distance between the cells of consecutive time steps of one vertex.
+        const size_t getTimeStride() const { return (m_layout == SequenceLayout::VertexMajor) ? m_width : m_size * m_width; }
+        // Distance between the cells of consecutive vertices at one time step.
+        const size_t getVertexStride() const { return (m_layout == SequenceLayout::VertexMajor) ? m_length * m_width : m_width; }
+
+        T *at(size_t vertex, size_t t) { return data() + vertex * getVertexStride() + t * getTimeStride(); }
+        const T *at(size_t vertex, size_t t) const { return data() + vertex * getVertexStride() + t * getTimeStride(); }
+        T *data()
+        {
+            detach();
+            return m_data.data() + m_offset;
+        }
+        const T *data() const { return m_external ? m_external : m_data.data() + m_offset; }
+        const bool isExternal() const { return m_external != nullptr; }
+
+        // Sets the dimensions, filling every cell with zeros.
+        void resize(size_t size, size_t length)
+        {
+            m_external = nullptr;
+            m_externalOwner.reset();
+            m_size = size;
+            m_length = length;
+            m_offset = 0;
+            m_data.assign(size * length * m_width, T());
+        }
+        void clear()
+        {
+            m_external = nullptr;
+            m_externalOwner.reset();
+            m_size = m_length = m_offset = 0;
+            std::vector<T>().swap(m_data);
+        }
+        /* Sets the length, keeping the first steps and filling the new ones
+         * with zeros. Appending is amortized O(N x added steps) when
+         * time-major and O(N x T) when vertex-major. */
+        void setLength(size_t length)
+        {
+            if (m_layout == SequenceLayout::TimeMajor)
+            {
+                detach();
+                m_data.resize(m_offset + m_size * length * m_width);
+                m_length = length;
+                return;
+            }
+            const SequenceArena<T> &self = *this;
+            std::vector<T> data(m_size * length * m_width);
+            const size_t kept = std::min(length, m_length) * m_width;
+            for (size_t v = 0; v < m_size; ++v)
+                std::copy(self.at(v, 0), self.at(v, 0) + kept, data.begin() + v * length * m_width);
+            m_external = nullptr;
+            m_externalOwner.reset();
+            m_data.swap(data);
+            m_offset = 0;
+            m_length = length;
+        }
+        /* Drops the first `count` steps: in amortized O(N x count) when
+         * time-major, where the cells are only offset (external ones without
+         * ever being copied), and in O(N x T) when vertex-major. */
+        void eraseFront(size_t count)
+        {
+            count = std::min(count, m_length);
+            const size_t length = m_length - count;
+            if (m_layout == SequenceLayout::TimeMajor)
+            {
+                m_length = length;
+                if (m_external)
+                {
+                    m_external += count * m_size * m_width;
+                    return;
+                }
+                m_offset += count * m_size * m_width;
+                if (m_offset > m_size * length * m_width)
+                {
+                    m_data.erase(m_data.begin(), m_data.begin() + m_offset);
+                    m_offset = 0;
+                }
+                return;
+            }
+            detach();
+            // Each row moves towards the front, so the copies never overlap a row still to be read.
+            T *cells = m_data.data() + m_offset;
+            for (size_t v = 0; v < m_size; ++v)
+                std::copy(cells + (v * m_length + count) * m_width, cells + (v + 1) * m_length * m_width, cells + v * length * m_width);
+            m_data.resize(m_offset + m_size * length * m_width);
+            m_length = length;
+        }
+        /* Reads the cells from `values`, laid out as `layout`, in place of an
+         * owned block. `owner` keeps the memory alive and is shared by the
+         * copies of the arena. */
+        void assignExternal(const T *values, size_t size, size_t length, SequenceLayout layout, std::shared_ptr<const void> owner)
+        {
+            clear();
+            m_size = size;
+            m_length = length;
+            m_layout = layout;
+            m_external = values;
+            m_externalOwner = std::move(owner);
+        }
+        void setLayout(SequenceLayout layout)
+        {
+            if (layout == m_layout)
+                return;
+            const SequenceArena<T> &self = *this;
+            SequenceArena<T> other(m_width, layout);
+            other.resize(m_size, m_length);
+            for (size_t v = 0; v < m_size; ++v)
+                for (size_t t = 0; t < m_length; ++t)
+                    std::copy(self.at(v, t), self.at(v, t) + m_width, other.at(v, t));
+            *this = std::move(other);
+        }
+
+        // Copies a sequence of width 1 given as `values[vertex][t]`.
+        void assign(const Matrix<T> &values)
+        {
+            if (m_width != 1)
+                throw std::logic_error("SequenceArena: cannot assign a matrix to cells of width " + std::to_string(m_width) + ".");
+            const size_t length = (values.size() == 0) ? 0 : values[0].size();
+            resize(values.size(), length);
+            for (size_t v = 0; v < m_size; ++v)
+            {
+                if (values[v].size() != length)
+                    throw std::logic_error("SequenceArena: sequence of vertex " + std::to_string(v) + " has length " + std::to_string(values[v].size()) + ", expected " + std::to_string(length) + ".");
+                for (size_t t = 0; t < length; ++t)
+                    *at(v, t) = values[v][t];
+            }
+        }
+    };
+
+    /* Vertices of one word of a PackedStateSequence, all counted `weight`
+     * times (e.g. the neighbours of a vertex joined by edges of equal
+     * multiplicity). */
+    struct PackedVertexMask
+    {
+        size_t word;
+        uint64_t bits;
+        int weight;
+    };
+
+    /* N x T sequence of binary states holding one bit per (vertex, time)
+     * cell: the states of vertices 64k, ..., 64k + 63 at time t are the bits
+     * of word t * getNumWords() + k. Counting the active vertices of a set is
+     * then one popcount per word the set spans. */
+    class PackedStateSequence
+    {
+        size_t m_size = 0, m_length = 0, m_numWords = 0;
+        std::vector<uint64_t> m_words;
+        // Start of the words of step 0 in m_words, as in SequenceArena.
+        size_t m_offset = 0;
+
+    public:
+        static const size_t WORD_SIZE = 64;
+
+        static int countBits(uint64_t word)
+        {
+#if defined(__GNUC__)
+            return __builtin_popcountll(word);
+#else
+            word -= (word >> 1) & 0x5555555555555555ULL;
+            word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+            word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+            return (word * 0x0101010101010101ULL) >> 56;
+#endif
+        }
+
+        const size_t size() const { return m_size; }
+        const size_t getLength() const { return m_length; }
+        // Number of words holding the states of all the vertices at one time step.
+        const size_t getNumWords() const { return m_numWords; }
+        const uint64_t *data() const { return m_words.data() + m_offset; }
+
+        const bool get(size_t vertex, size_t t) const
+        {
+            return (m_words[m_offset + t * m_numWords + vertex / WORD_SIZE] >> (vertex % WORD_SIZE)) & 1;
+        }
+        /* Sets one cell. Cells of vertices in different words can be set from
+         * different threads. */
+        void set(size_t vertex, size_t t, bool state)
+        {
+            uint64_t &word = m_words[m_offset + t * m_numWords + vertex / WORD_SIZE];
+            const uint64_t bit = uint64_t(1) << (vertex % WORD_SIZE);
+            word = state ? (word | bit) : (word & ~bit);
+        }
+
+        // Weighted number of active vertices of `masks` at time t.
+        const int countActive(const PackedVertexMask *masks, size_t numMasks, size_t t) const
+        {
+            const uint64_t *words = data() + t * m_numWords;
+            int count = 0;
+            for (size_t i = 0; i < numMasks; i++)
+                count += masks[i].weight * countBits(words[masks[i].word] & masks[i].bits);
+            return count;
+        }
+
+        // Sets the dimensions, with every state inactive.
+        void resize(size_t size, size_t length)
+        {
+            m_size = size;
+            m_length = length;
+            m_numWords = (size + WORD_SIZE - 1) / WORD_SIZE;
+            m_offset = 0;
+            m_words.assign(m_numWords * length, 0);
+        }
+        void clear()
+        {
+            m_size = m_length = m_numWords = m_offset = 0;
+            std::vector<uint64_t>().swap(m_words);
+        }
+
+        // Sets the length, keeping the first steps and clearing the new ones, in amortized O(N x added steps).
+        void setLength(size_t length)
+        {
+            m_words.resize(m_offset + m_numWords * length);
+            m_length = length;
+        }
+        // Drops the first `count` steps in amortized O(N x count).
+        void eraseFront(size_t count)
+        {
+            count = std::min(count, m_length);
+            m_length -= count;
+            m_offset += count * m_numWords;
+            if (m_offset > m_numWords * m_length)
+            {
+                m_words.erase(m_words.begin(), m_words.begin() + m_offset);
+                m_offset = 0;
+            }
+        }
+
+        // Copies the states of `vertex` at first, ..., first + length - 1 to values[t * stride].
+        template <typename T>
+        void unpack(size_t vertex, T *values, size_t first, size_t length, size_t stride = 1) const
+        {
+            const uint64_t *words = data() + first * m_numWords + vertex / WORD_SIZE;
+            const size_t shift = vertex % WORD_SIZE;
+            for (size_t t = 0; t < length; ++t)
+                values[t * stride] = (words[t * m_numWords] >> shift) & 1;
+        }
+        // Sets the states of `vertex` from first on from values[t * stride], each 0 or 1.
+        template <typename T>
+        void pack(size_t vertex, const T *values, size_t first, size_t length, size_t stride = 1)
+        {
+            for (size_t t = 0; t < length; ++t)
+            {
+                const T value = values[t * stride];
+                if (value != 0 and value != 1)
+                    throw std::logic_error("PackedStateSequence: state " + std::to_string(value) + " of vertex " + std::to_string(vertex) + " is not binary.");
+                set(vertex, first + t, value);
+            }
+        }
+
+        template <typename T>
+        void assign(const SequenceArena<T> &arena)
+        {
+            if (arena.getWidth() != 1)
+                throw std::logic_error("PackedStateSequence: cannot pack cells of width " + std::to_string(arena.getWidth()) + ".");
+            resize(arena.size(), arena.getLength());
+            for (size_t v = 0; v < m_size; ++v)
+                pack(v, arena.at(v, 0), 0, m_length, arena.getTimeStride());
+        }
+        // Copies a sequence given as `values[vertex][t]`.
+        template <typename T>
+        void assign(const Matrix<T> &values)
+        {
+            const size_t length = (values.size() == 0) ? 0 : values[0].size();
+            resize(values.size(), length);
+            for (size_t v = 0; v < m_size; ++v)
+            {
+                if (values[v].size() != length)
+                    throw std::logic_error("PackedStateSequence: sequence of vertex " + std::to_string(v) + " has length " + std::to_string(values[v].size()) + ", expected " + std::to_string(length) + ".");
+                pack(v, values[v].data(), 0, length);
+            }
+        }
+    };
+
+    /* Read-only views of a SequenceArena, indexed like the nested vectors
+     * they replace: `view[vertex][t]` for states, and `view[vertex][t][s]`
+     * for neighbour counts. They are invalidated when the arena is resized
+     * and convert to nested vectors to take a copy. States also have views
+     * of a PackedStateSequence, and of the `length` steps of a sequence
+     * from `first` on. */
+    template <typename T>
+    class CellView
+    {
+        const T *m_data;
+        size_t m_width;
+
+    public:
+        CellView(const T *data, size_t width) : m_data(data), m_width(width) {}
+        const T &operator[](size_t s) const { return m_data[s]; }
+        const size_t size() const { return m_width; }
+        const T *begin() const { return m_data; }
+        const T *end() const { return m_data + m_width; }
+        operator std::vector<T>() const { return std::vector<T>(begin(), end()); }
+    };
+
+    template <typename T>
+    class VertexSequenceView
+    {
+        const T *m_data = nullptr;
+        const uint64_t *m_words = nullptr;
+        size_t m_length, m_stride, m_shift = 0;
+
+    public:
+        VertexSequenceView(const T *data, size_t length, size_t stride) : m_data(data), m_length(length), m_stride(stride) {}
+        VertexSequenceView(const uint64_t *words, size_t length, size_t stride, size_t shift) : m_words(words), m_length(length), m_stride(stride), m_shift(shift) {}
+        const T operator[](size_t t) const { return m_words ? T((m_words[t * m_stride] >> m_shift) & 1) : m_data[t * m_stride]; }
+        const size_t size() const { return m_length; }
+        operator std::vector<T>() const
+        {
+            std::vector<T> values(m_length);
+            for (size_t t = 0; t < m_length; ++t)
+                values[t] = (*this)[t];
+            return values;
+        }
+    };
+
+    template <typename T>
+    class VertexCellSequenceView
+    {
+        const T *m_data;
+        size_t m_length, m_stride, m_width;
+
+    public:
+        VertexCellSequenceView(const T *data, size_t length, size_t stride, size_t width) : m_data(data), m_length(length), m_stride(stride), m_width(width) {}
+        const CellView<T> operator[](size_t t) const { return CellView<T>(m_data + t * m_stride, m_width); }
+        const size_t size() const { return m_length; }
+        operator Matrix<T>() const
+        {
+            Matrix<T> values(m_length);
+            for (size_t t = 0; t < m_length; ++t)
+                values[t] = (*this)[t];
+            return values;
+        }
+    };
+
+    template <typename T>
+    class SequenceView
+    {
+        const SequenceArena<T> *m_arena = nullptr;
+        const PackedStateSequence *m_packed = nullptr;
+        size_t m_first, m_length;
+
+    public:
+        SequenceView(const SequenceArena<T> &arena) : m_arena(&arena), m_first(0), m_length(arena.getLength()) {}
+        SequenceView(const SequenceArena<T> &arena, size_t first, size_t length) : m_arena(&arena), m_first(first), m_length(length) {}
+        SequenceView(const PackedStateSequence &packed) : m_packed(&packed), m_first(0), m_length(packed.getLength()) {}
+        SequenceView(const PackedStateSequence &packed, size_t first, size_t length) : m_packed(&packed), m_first(first), m_length(length) {}
+        const VertexSequenceView<T> operator[](size_t vertex) const
+        {
+            if (m_packed)
+                return VertexSequenceView<T>(m_packed->data() + m_first * m_packed->getNumWords() + vertex / PackedStateSequence::WORD_SIZE,
+                                             m_length, m_packed->getNumWords(), vertex % PackedStateSequence::WORD_SIZE);
+            return VertexSequenceView<T>(m_arena->at(vertex, m_first), m_length, m_arena->getTimeStride());
+        }
+        const size_t size() const { return m_packed ? m_packed->size() : m_arena->size(); }
+        operator Matrix<T>() const
+        {
+            Matrix<T> values(size());
+            for (size_t v = 0; v < size(); ++v)
+                values[v] = (*this)[v];
+            return values;
+        }
+    };
+
+    template <typename T>
+    class CellSequenceView
+    {
+        const SequenceArena<T> *m_arena;
+
+    public:
+        CellSequenceView(const SequenceArena<T> &arena) : m_arena(&arena) {}
+        const VertexCellSequenceView<T> operator[](size_t vertex) const
+        {
+            return VertexCellSequenceView<T>(m_arena->at(vertex, 0), m_arena->getLength(), m_arena->getTimeStride(), m_arena->getWidth());
+        }
+        const size_t size() const { return m_arena->size(); }
+        operator Matrix<std::vector<T>>() const
+        {
+            Matrix<std::vector<T>> values(size());
+            for (size_t v = 0; v < size(); ++v)
+                values[v] = (*this)[v];
+            return values;
+        }
+    };
+
+}
+
+#endif
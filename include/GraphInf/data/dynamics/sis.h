@@ -36,6 +36,9 @@ namespace GraphInf
             m_paramProposer.insertGaussianProposer("recovery", 1.0, 0.0, recoveryStddev);
         }
 
+        // Only the active neighbours matter.
+        const bool dependsOnInactiveNeighbors() const override { return false; }
+
         const double getActivationProb(const VertexNeighborhoodState &vertexNeighborState) const override
         {
             return 1 - std::pow(1 - getInfectionProb(), vertexNeighborState[1]);
@@ -46,9 +49,17 @@ namespace GraphInf
         }
 
         const double getInfectionProb() const { return m_infectionProb; }
-        void setInfectionProb(double infectionProb) { m_infectionProb = infectionProb; }
+        void setInfectionProb(double infectionProb)
+        {
+            m_infectionProb = infectionProb;
+            computeLogLikelihoodCache();
+        }
         const double getRecoveryProb() const { return m_recoveryProb; }
-        void setRecoveryProb(double recoveryProb) { m_recoveryProb = recoveryProb; }
+        void setRecoveryProb(double recoveryProb)
+        {
+            m_recoveryProb = recoveryProb;
+            computeLogLikelihoodCache();
+        }
         void applyParamMove(const ParamMove &move) override
         {
             if (move.key == "infection")
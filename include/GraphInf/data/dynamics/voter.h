@@ -35,7 +35,11 @@ namespace GraphInf
         }
 
         const double getRandomFlipProb() const { return m_random_flip_prob; }
-        void setRandomFlipProb(double random_flip_prob) { m_random_flip_prob = random_flip_prob; }
+        void setRandomFlipProb(double random_flip_prob)
+        {
+            m_random_flip_prob = random_flip_prob;
+            computeLogLikelihoodCache();
+        }
 
         const double getActivationProb(const VertexNeighborhoodState &vertexNeighborState) const override
         {
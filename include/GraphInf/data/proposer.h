@@ -17,10 +17,16 @@ namespace GraphInf
 
     class ParamProposer
     {
+    protected:
+        RNG *m_rngPtr = &rng;
+        size_t m_keyIndex = ParamKeyRegistry::NONE;
 
     public:
         ParamProposer() {}
         virtual ~ParamProposer() {}
+        void setRNG(RNG &gen) { m_rngPtr = &gen; }
+        void setKeyIndex(size_t keyIndex) { m_keyIndex = keyIndex; }
+        size_t getKeyIndex() const { return m_keyIndex; }
 
         virtual double proposeMove() const = 0;
         virtual double logProposal(const double move) const = 0;
@@ -38,7 +44,7 @@ namespace GraphInf
 
         double proposeMove() const override
         {
-            if (m_bernoulli(rng))
+            if (m_bernoulli(*m_rngPtr))
                 return m_stepSize;
             return -m_stepSize;
         }
@@ -60,7 +66,7 @@ namespace GraphInf
     public:
         GaussianParamProposer(const double mean = 0, const double stddev = 0.1) : ParamProposer(), m_mean(mean), m_stddev(stddev), m_normal(mean, stddev) {}
 
-        double proposeMove() const override { return m_normal(rng); }
+        double proposeMove() const override { return m_normal(*m_rngPtr); }
 
         double logProposal(const double move) const override
         {
@@ -93,6 +99,7 @@ namespace GraphInf
     private:
         sset::SamplableSet<std::string> m_moveSampler;
         std::map<std::string, std::shared_ptr<ParamProposer>> m_proposersPtrMap;
+        RNG *m_rngPtr = &rng;
 
     public:
         MultiParamProposer(double min = 1, double max = 10) : m_moveSampler(min, max) {}
@@ -102,6 +109,8 @@ namespace GraphInf
             if (p <= 0 || p > 1)
                 return;
             m_proposersPtrMap.insert({key, std::shared_ptr<ParamProposer>(new StepParamProposer(stepSize, p))});
+            m_proposersPtrMap.at(key)->setRNG(*m_rngPtr);
+            m_proposersPtrMap.at(key)->setKeyIndex(ParamKeyRegistry::getIndex(key));
             m_moveSampler.insert(key, rate);
         }
         void insertGaussianProposer(std::string key, double rate = 1, double mean = 0, double scale = 0.1)
@@ -109,6 +118,8 @@ namespace GraphInf
             if (scale <= 0)
                 return;
             m_proposersPtrMap.insert({key, std::shared_ptr<ParamProposer>(new GaussianParamProposer(mean, scale))});
+            m_proposersPtrMap.at(key)->setRNG(*m_rngPtr);
+            m_proposersPtrMap.at(key)->setKeyIndex(ParamKeyRegistry::getIndex(key));
             m_moveSampler.insert(key, rate);
         }
         void erase(std::string key)
@@ -117,6 +128,12 @@ namespace GraphInf
             m_moveSampler.erase(key);
         }
         size_t size() { return m_moveSampler.size(); }
+        void setRNG(RNG &gen)
+        {
+            m_rngPtr = &gen;
+            for (auto &proposer : m_proposersPtrMap)
+                proposer.second->setRNG(gen);
+        }
         void freeze(std::string key)
         {
             m_moveSampler.erase(key);
@@ -130,12 +147,12 @@ namespace GraphInf
 
         const ParamMove proposeMove(std::string key) const
         {
-            auto value = m_proposersPtrMap.at(key)->proposeMove();
-            return ParamMove(key, value);
+            const auto &proposer = m_proposersPtrMap.at(key);
+            return ParamMove(key, proposer->proposeMove(), proposer->getKeyIndex());
         }
         const ParamMove proposeMove() const
         {
-            const auto key = m_moveSampler.sample_ext_RNG(rng).first;
+            const auto key = m_moveSampler.sample_ext_RNG(*m_rngPtr).first;
             return proposeMove(key);
         }
         double logProposalRatio(const ParamMove move) const
@@ -49,7 +49,22 @@ namespace GraphInf
     class PyDynamics : public PyDataModel<BaseClass>
     {
     public:
-        using PyDataModel<BaseClass>::PyDataModel;
+        /* Python subclasses may change their transition probabilities at any
+         * time, so they do not cache the log-likelihood. Their transition
+         * probabilities need the GIL, which the caller holds while it waits on
+         * the model's pool, so the model keeps a single thread. */
+        template <typename... Args>
+        PyDynamics(Args &&...args) : PyDataModel<BaseClass>(std::forward<Args>(args)...)
+        {
+            this->setLogLikelihoodCaching(false);
+            this->m_threadPool.setThreadCount(1);
+        }
+        // Only the graph prior takes `threadCount`.
+        void setThreadCount(size_t threadCount) override
+        {
+            BaseClass::setThreadCount(threadCount);
+            this->m_threadPool.setThreadCount(1);
+        }
 
         /* Pure abstract methods */
         const double getTransitionProb(
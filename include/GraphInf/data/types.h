@@ -2,6 +2,7 @@
 #define GRAPH_INF_DYNAMICS_TYPES_H
 
 #include <vector>
+#include <map>
 
 namespace GraphInf
 {
@@ -15,6 +16,7 @@ namespace GraphInf
     typedef std::vector<VertexNeighborhoodState> VertexNeighborhoodStateSequence;
     typedef std::vector<VertexNeighborhoodState> NeighborsState; // neighborsState = [vertexState1, vertexState2, ...]; dim = N x D
     typedef std::vector<NeighborsState> NeighborsStateSequence;  // neighborsStateSequence = [neighborsState1, neighborsState2, ...]; dim = T x N x D
+    typedef std::map<VertexNeighborhoodState, size_t> TransitionCounts; // [prevState, nextState, neighborsState...] -> count
 
 }
 
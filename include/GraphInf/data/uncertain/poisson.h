@@ -5,6 +5,7 @@
 #include <stdexcept>
 #include "GraphInf/rng.h"
 #include "GraphInf/types.h"
+#include "GraphInf/utility/functions.h"
 #include "uncertain.h"
 
 namespace GraphInf
@@ -33,7 +34,7 @@ namespace GraphInf
                     double average = getAverage(graph.getEdgeMultiplicity(i, j));
 
                     m_state.setEdgeMultiplicity(i, j,
-                                                std::poisson_distribution<size_t>(average)(rng));
+                                                std::poisson_distribution<size_t>(average)(*m_rngPtr));
                 }
             }
         }
@@ -50,7 +51,7 @@ namespace GraphInf
                     const auto &observation = m_state.getEdgeMultiplicity(i, j);
                     double average = getAverage(graph.getEdgeMultiplicity(i, j));
 
-                    logLikelihood += observation * log(average) - average - lgamma(observation + 1);
+                    logLikelihood += observation * log(average) - average - logFactorial(observation);
                 }
             }
             return logLikelihood;
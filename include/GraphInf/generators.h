@@ -17,40 +17,40 @@ namespace GraphInf
 {
 
     template <typename InType, typename OutType>
-    OutType generateCategorical(const std::vector<InType> &probs)
+    OutType generateCategorical(const std::vector<InType> &probs, RNG &gen = rng)
     {
         std::discrete_distribution<OutType> dist(probs.begin(), probs.end());
-        return dist(rng);
+        return dist(gen);
     };
-    std::vector<size_t> sampleUniformlySequenceWithoutReplacement(size_t n, size_t k);
-    std::list<size_t> sampleRandomComposition(size_t n, size_t k);
-    std::list<size_t> sampleRandomWeakComposition(size_t n, size_t k);
-    std::list<size_t> sampleRandomRestrictedPartition(size_t n, size_t k, size_t numberOfSteps = 0);
-    std::vector<size_t> sampleRandomPermutation(const std::vector<size_t> &nk);
-    std::vector<size_t> sampleMultinomial(const size_t n, const std::vector<double> &p);
-    std::vector<size_t> sampleUniformMultinomial(const size_t n, const size_t k);
+    std::vector<size_t> sampleUniformlySequenceWithoutReplacement(size_t n, size_t k, RNG &gen = rng);
+    std::list<size_t> sampleRandomComposition(size_t n, size_t k, RNG &gen = rng);
+    std::list<size_t> sampleRandomWeakComposition(size_t n, size_t k, RNG &gen = rng);
+    std::list<size_t> sampleRandomRestrictedPartition(size_t n, size_t k, size_t numberOfSteps = 0, RNG &gen = rng);
+    std::vector<size_t> sampleRandomPermutation(const std::vector<size_t> &nk, RNG &gen = rng);
+    std::vector<size_t> sampleMultinomial(const size_t n, const std::vector<double> &p, RNG &gen = rng);
+    std::vector<size_t> sampleUniformMultinomial(const size_t n, const size_t k, RNG &gen = rng);
 
     BaseGraph::VertexIndex sampleRandomNeighbor(
-        const MultiGraph &graph, const BaseGraph::VertexIndex vertex, bool withMultiplicity = true);
+        const MultiGraph &graph, const BaseGraph::VertexIndex vertex, bool withMultiplicity = true, RNG &gen = rng);
 
     template <typename T>
-    T sampleUniformly(T min, T max)
+    T sampleUniformly(T min, T max, RNG &gen = rng)
     {
         std::uniform_int_distribution<> dist(min, max);
-        return dist(rng);
+        return dist(gen);
     }
 
     template <typename T, typename out>
-    out sampleUniformlyFrom(T sequence)
+    out sampleUniformlyFrom(T sequence, RNG &gen = rng)
     {
-        return *sampleUniformlyFrom<T>(sequence.begin(), sequence.end());
+        return *sampleUniformlyFrom<T>(sequence.begin(), sequence.end(), gen);
     }
 
     template <typename Iterator>
-    Iterator sampleUniformlyFrom(Iterator start, Iterator end)
+    Iterator sampleUniformlyFrom(Iterator start, Iterator end, RNG &gen = rng)
     {
         std::uniform_int_distribution<> dist(0, std::distance(start, end) - 1);
-        std::advance(start, dist(rng));
+        std::advance(start, dist(gen));
         return start;
     }
 
@@ -72,20 +72,20 @@ namespace GraphInf
         return values;
     }
 
-    BaseGraph::UndirectedMultigraph generateDCSBM(const BlockSequence &vertexBlocks, const LabelGraph &blockEdgeMatrix, const DegreeSequence &degrees);
-    BaseGraph::UndirectedMultigraph generateStubLabeledSBM(const BlockSequence &vertexBlocks, const LabelGraph &labelGraph, bool withSelfLoops = true);
-    BaseGraph::UndirectedMultigraph generateMultiGraphSBM(const BlockSequence &vertexBlocks, const LabelGraph &labelGraph, bool withSelfLoops = true);
-    BaseGraph::UndirectedMultigraph generateSBM(const BlockSequence &vertexBlocks, const LabelGraph &labelGraph, bool withSelfLoops = true);
-    MultiGraph generateCM(const DegreeSequence &degrees);
+    BaseGraph::UndirectedMultigraph generateDCSBM(const BlockSequence &vertexBlocks, const LabelGraph &blockEdgeMatrix, const DegreeSequence &degrees, RNG &gen = rng);
+    BaseGraph::UndirectedMultigraph generateStubLabeledSBM(const BlockSequence &vertexBlocks, const LabelGraph &labelGraph, bool withSelfLoops = true, RNG &gen = rng);
+    BaseGraph::UndirectedMultigraph generateMultiGraphSBM(const BlockSequence &vertexBlocks, const LabelGraph &labelGraph, bool withSelfLoops = true, RNG &gen = rng);
+    BaseGraph::UndirectedMultigraph generateSBM(const BlockSequence &vertexBlocks, const LabelGraph &labelGraph, bool withSelfLoops = true, RNG &gen = rng);
+    MultiGraph generateCM(const DegreeSequence &degrees, RNG &gen = rng);
 
-    MultiGraph generateErdosRenyi(size_t size, size_t edgeCount, bool withSelfLoops = true);
-    MultiGraph generateStubLabeledErdosRenyi(size_t size, size_t edgeCount, bool withSelfLoops = true);
-    MultiGraph generateMultiGraphErdosRenyi(size_t size, size_t edgeCount, bool withSelfLoops = true);
+    MultiGraph generateErdosRenyi(size_t size, size_t edgeCount, bool withSelfLoops = true, RNG &gen = rng);
+    MultiGraph generateStubLabeledErdosRenyi(size_t size, size_t edgeCount, bool withSelfLoops = true, RNG &gen = rng);
+    MultiGraph generateMultiGraphErdosRenyi(size_t size, size_t edgeCount, bool withSelfLoops = true, RNG &gen = rng);
 
     template <typename T>
-    T pickElementUniformly(const std::vector<T> &sequence)
+    T pickElementUniformly(const std::vector<T> &sequence, RNG &gen = rng)
     {
-        return sequence[std::uniform_int_distribution<size_t>(0, sequence.size() - 1)(rng)];
+        return sequence[std::uniform_int_distribution<size_t>(0, sequence.size() - 1)(gen)];
     }
 
 } // namespace GraphInf
@@ -69,9 +69,15 @@ namespace GraphInf
 
         void computationFinished() const override
         {
-            m_isProcessed = false;
+            NestedRandomVariable::computationFinished();
             m_degreePriorPtr->computationFinished();
         }
+        void setRNG(RNG &gen) override
+        {
+            RandomGraph::setRNG(gen);
+            if (m_degreePriorPtr)
+                m_degreePriorPtr->setRNG(gen);
+        }
 
         void checkSelfConsistency() const override
         {
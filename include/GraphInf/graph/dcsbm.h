@@ -142,9 +142,15 @@ namespace GraphInf
         // }
         void computationFinished() const override
         {
-            m_isProcessed = false;
+            NestedRandomVariable::computationFinished();
             m_degreePriorPtr->computationFinished();
         }
+        void setRNG(RNG &gen) override
+        {
+            VertexLabeledRandomGraph<BlockIndex>::setRNG(gen);
+            if (m_degreePriorPtr)
+                m_degreePriorPtr->setRNG(gen);
+        }
 
         void checkSelfSafety() const override
         {
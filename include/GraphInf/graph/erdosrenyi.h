@@ -60,7 +60,7 @@ namespace GraphInf
         // }
         void computationFinished() const override
         {
-            m_isProcessed = false;
+            NestedRandomVariable::computationFinished();
             m_edgeCountPriorPtr->computationFinished();
         }
         void checkSelfSafety() const override
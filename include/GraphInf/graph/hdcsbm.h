@@ -142,9 +142,16 @@ namespace GraphInf
 
         void computationFinished() const override
         {
-            m_isProcessed = false;
+            NestedRandomVariable::computationFinished();
             m_degreePriorPtr->computationFinished();
         }
+        void setRNG(RNG &gen) override
+        {
+            NestedVertexLabeledRandomGraph<BlockIndex>::setRNG(gen);
+            m_nestedLabelGraphPrior.setRNG(gen);
+            if (m_degreePriorPtr)
+                m_degreePriorPtr->setRNG(gen);
+        }
         bool isValidLabelMove(const BlockMove &move) const override
         {
             return m_nestedLabelGraphPrior.getNestedBlockPrior().isValidBlockMove(move);
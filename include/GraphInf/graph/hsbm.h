@@ -130,9 +130,14 @@ namespace GraphInf
         // }
         void computationFinished() const override
         {
-            m_isProcessed = false;
+            NestedRandomVariable::computationFinished();
             m_nestedLabelGraphPrior.computationFinished();
         }
+        void setRNG(RNG &gen) override
+        {
+            NestedVertexLabeledRandomGraph<BlockIndex>::setRNG(gen);
+            m_nestedLabelGraphPrior.setRNG(gen);
+        }
         bool isValidLabelMove(const BlockMove &move) const override
         {
             return m_nestedLabelGraphPrior.getNestedBlockPrior().isValidBlockMove(move);
@@ -16,7 +16,7 @@ namespace GraphInf
     public:
         const MultiGraph sample() const override
         {
-            return generateCM((*m_degreePriorPtrPtr)->getState());
+            return generateCM((*m_degreePriorPtrPtr)->getState(), *m_rngPtr);
         }
         const double getLogLikelihood() const override;
         const double getLogLikelihoodRatioFromGraphMove(const GraphMove &move) const override;
@@ -27,7 +27,7 @@ namespace GraphInf
             const auto &blocks = (*m_degreePriorPtrPtr)->getBlockPrior().getState();
             const auto &labelGraph = (*m_degreePriorPtrPtr)->getLabelGraphPrior().getState();
             const auto &degrees = (*m_degreePriorPtrPtr)->getState();
-            return generateDCSBM(blocks, labelGraph, degrees);
+            return generateDCSBM(blocks, labelGraph, degrees, *m_rngPtr);
         }
         const double getLogLikelihood() const override;
         const double getLogLikelihoodRatioFromGraphMove(const GraphMove &) const override;
@@ -34,7 +34,7 @@ namespace GraphInf
         const MultiGraph sample() const
         {
             const auto &generate = (*m_withParallelEdgesPtr) ? generateMultiGraphErdosRenyi : generateErdosRenyi;
-            return generate(*m_graphSizePtr, (*m_edgeCountPriorPtrPtr)->getState(), *m_withSelfLoopsPtr);
+            return generate(*m_graphSizePtr, (*m_edgeCountPriorPtrPtr)->getState(), *m_withSelfLoopsPtr, *m_rngPtr);
         }
         const double getLogLikelihood() const
         {
@@ -35,7 +35,7 @@ namespace GraphInf
         {
             const auto &blocks = (*m_labelGraphPriorPtrPtr)->getBlocks();
             const auto &labelGraph = (*m_labelGraphPriorPtrPtr)->getState();
-            return generateStubLabeledSBM(blocks, labelGraph, true);
+            return generateStubLabeledSBM(blocks, labelGraph, true, *m_rngPtr);
         }
         const double getLogLikelihood() const override;
         const double getLogLikelihoodRatioFromGraphMove(const GraphMove &) const override;
@@ -74,7 +74,7 @@ namespace GraphInf
             const auto &blocks = (*m_labelGraphPriorPtrPtr)->getBlocks();
             const auto &labelGraph = (*m_labelGraphPriorPtrPtr)->getState();
             const auto &generate = (*m_withParallelEdgesPtr) ? generateMultiGraphSBM : generateSBM;
-            return generate(blocks, labelGraph, *m_withSelfLoopsPtr);
+            return generate(blocks, labelGraph, *m_withSelfLoopsPtr, *m_rngPtr);
         }
         const double getLogLikelihood() const override;
         const double getLogLikelihoodRatioFromGraphMove(const GraphMove &) const override;
@@ -129,9 +129,15 @@ namespace GraphInf
 
         void computationFinished() const override
         {
-            m_isProcessed = false;
+            NestedRandomVariable::computationFinished();
             m_blockCountPriorPtr->computationFinished();
         }
+        void setRNG(RNG &gen) override
+        {
+            NestedRandomVariable::setRNG(gen);
+            if (m_blockCountPriorPtr)
+                m_blockCountPriorPtr->setRNG(gen);
+        }
 
         void checkSelfConsistency() const override
         {
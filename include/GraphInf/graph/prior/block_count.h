@@ -135,7 +135,7 @@ namespace GraphInf
             setMin(min);
             setMax(max);
         }
-        void sampleState() override { setState(m_uniformDistribution(rng)); }
+        void sampleState() override { setState(m_uniformDistribution(*m_rngPtr)); }
         const double getLogLikelihoodFromState(const size_t &state) const override
         {
             if (state > m_max or state < m_min)
@@ -244,11 +244,11 @@ namespace GraphInf
         {
             std::vector<size_t> nestedState;
             std::uniform_int_distribution<size_t> dist(1, m_graphSize - 1);
-            nestedState.push_back(dist(rng));
+            nestedState.push_back(dist(*m_rngPtr));
             while (nestedState.back() != 1)
             {
                 std::uniform_int_distribution<size_t> nestedDist(1, nestedState.back() - 1);
-                nestedState.push_back(nestedDist(rng));
+                nestedState.push_back(nestedDist(*m_rngPtr));
             }
             setNestedState(nestedState);
         }
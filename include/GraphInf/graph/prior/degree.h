@@ -81,9 +81,15 @@ namespace GraphInf
 
         virtual void computationFinished() const override
         {
-            m_isProcessed = false;
+            NestedRandomVariable::computationFinished();
             m_edgeCountPriorPtr->computationFinished();
         }
+        void setRNG(RNG &gen) override
+        {
+            NestedRandomVariable::setRNG(gen);
+            if (m_edgeCountPriorPtr)
+                m_edgeCountPriorPtr->setRNG(gen);
+        }
         static void checkDegreeSequenceConsistencyWithEdgeCount(const DegreeSequence &, size_t);
         static void checkDegreeSequenceConsistencyWithDegreeCounts(const DegreeSequence &, const DegreeCountsMap &);
 
@@ -142,7 +148,7 @@ namespace GraphInf
                 throw SafetyError("DegreeDeltaPrior", "m_degreeSeq");
         }
 
-        void computationFinished() const override { m_isProcessed = false; }
+        void computationFinished() const override { NestedRandomVariable::computationFinished(); }
     };
 
     class DegreeUniformPrior : public DegreePrior
@@ -101,7 +101,7 @@ namespace GraphInf
             m_mean = mean;
             m_poissonDistribution = std::poisson_distribution<size_t>(mean);
         }
-        void sampleState() override { setState(m_poissonDistribution(rng)); }
+        void sampleState() override { setState(m_poissonDistribution(*m_rngPtr)); }
         const double getLogLikelihoodFromState(const size_t &state) const override { return logPoissonPMF(state, m_mean); }
         void checkSelfSafety() const override
         {
@@ -141,7 +141,7 @@ namespace GraphInf
             double p = 1. / (m_mean + 1);
             m_geometricDistribution = std::geometric_distribution<size_t>(p);
         }
-        void sampleState() override { setState(m_geometricDistribution(rng)); }
+        void sampleState() override { setState(m_geometricDistribution(*m_rngPtr)); }
         const double getLogLikelihoodFromState(const size_t &state) const override
         {
             double p = 1. / (m_mean + 1);
@@ -164,7 +164,7 @@ namespace GraphInf
 
     public:
         EdgeCountUniformPrior() {}
-        EdgeCountUniformPrior(double min, double max) : m_min(min), m_max(max), m_uniformDistribution(min, max) { setState(m_uniformDistribution(rng)); }
+        EdgeCountUniformPrior(double min, double max) : m_min(min), m_max(max), m_uniformDistribution(min, max) { setState(m_uniformDistribution(*m_rngPtr)); }
         EdgeCountUniformPrior(const EdgeCountUniformPrior &other)
         {
             setMinMax(other.getMin(), other.getMax());
@@ -186,7 +186,7 @@ namespace GraphInf
             m_max = max;
             m_uniformDistribution = std::uniform_int_distribution<size_t>(min, max);
         }
-        void sampleState() override { setState(m_uniformDistribution(rng)); }
+        void sampleState() override { setState(m_uniformDistribution(*m_rngPtr)); }
         const double getLogLikelihoodFromState(const size_t &state) const override
         {
             if (state >= m_min && state <= m_max)
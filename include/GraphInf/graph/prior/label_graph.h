@@ -151,10 +151,18 @@ namespace GraphInf
         }
         void computationFinished() const override
         {
-            m_isProcessed = false;
+            NestedRandomVariable::computationFinished();
             m_blockPriorPtr->computationFinished();
             m_edgeCountPriorPtr->computationFinished();
         }
+        void setRNG(RNG &gen) override
+        {
+            NestedRandomVariable::setRNG(gen);
+            if (m_blockPriorPtr)
+                m_blockPriorPtr->setRNG(gen);
+            if (m_edgeCountPriorPtr)
+                m_edgeCountPriorPtr->setRNG(gen);
+        }
         void checkSelfConsistencywithGraph() const;
         virtual void checkSelfConsistency() const override;
 
@@ -217,7 +225,7 @@ namespace GraphInf
                 throw SafetyError("LabelGraphDeltaPrior", "m_labelGraph", "empty");
         }
 
-        void computationFinished() const override { m_isProcessed = false; }
+        void computationFinished() const override { NestedRandomVariable::computationFinished(); }
     };
 
     class LabelGraphErdosRenyiPrior : public LabelGraphPrior
@@ -95,9 +95,15 @@ namespace GraphInf
 
         virtual void computationFinished() const override
         {
-            m_isProcessed = false;
+            NestedRandomVariable::computationFinished();
             m_labelGraphPriorPtr->computationFinished();
         }
+        void setRNG(RNG &gen) override
+        {
+            NestedRandomVariable::setRNG(gen);
+            if (m_labelGraphPriorPtr)
+                m_labelGraphPriorPtr->setRNG(gen);
+        }
         static void checkDegreeSequenceConsistencyWithEdgeCount(const DegreeSequence &, size_t);
         static void checkDegreeSequenceConsistencyWithDegreeCounts(const DegreeSequence &, const BlockSequence &, const VertexLabeledDegreeCountsMap &);
 
@@ -155,7 +161,7 @@ namespace GraphInf
                 throw SafetyError("DegreeDeltaPrior", "m_degreeSeq", "empty");
         }
 
-        void computationFinished() const override { m_isProcessed = false; }
+        void computationFinished() const override { NestedRandomVariable::computationFinished(); }
     };
 
     class VertexLabeledDegreeUniformPrior : public VertexLabeledDegreePrior
@@ -146,9 +146,15 @@ namespace GraphInf
         /* Consistency methods */
         void computationFinished() const override
         {
-            m_isProcessed = false;
+            NestedRandomVariable::computationFinished();
             m_nestedBlockCountPriorPtr->computationFinished();
         }
+        void setRNG(RNG &gen) override
+        {
+            BlockPrior::setRNG(gen);
+            if (m_nestedBlockCountPriorPtr)
+                m_nestedBlockCountPriorPtr->setRNG(gen);
+        }
 
         void checkLevel(std::string prefix, Level level) const
         {
@@ -29,6 +29,11 @@ namespace GraphInf
         const double getLogProposalProbRatio(const GraphMove &move) const override;
 
         void applyGraphMove(const GraphMove &) override;
+        void setRNG(RNG &gen) override
+        {
+            EdgeProposer::setRNG(gen);
+            m_edgeSampler.setRNG(gen);
+        }
         void clear() override { m_edgeSampler.clear(); }
     };
 
@@ -22,7 +22,7 @@ namespace GraphInf
         {
             if (m_graphPtr->getTotalEdgeNumber() == 0)
                 return {};
-            if (m_sampleHingeFlip(rng) || m_graphPtr->getTotalEdgeNumber() < 2)
+            if (m_sampleHingeFlip(*m_rngPtr) || m_graphPtr->getTotalEdgeNumber() < 2)
                 return m_hingeFlipProposer.proposeRawMove();
             return m_doubleEdgeSwapProposer.proposeRawMove();
         }
@@ -45,6 +45,12 @@ namespace GraphInf
                 return m_doubleEdgeSwapProposer.getLogProposalProbRatio(move);
             return 0;
         }
+        void setRNG(RNG &gen) override
+        {
+            EdgeProposer::setRNG(gen);
+            m_hingeFlipProposer.setRNG(gen);
+            m_doubleEdgeSwapProposer.setRNG(gen);
+        }
         void checkSelfSafety() const override
         {
             EdgeProposer::checkSelfSafety();
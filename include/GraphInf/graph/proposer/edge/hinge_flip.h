@@ -43,6 +43,13 @@ namespace GraphInf
         void setUpWithGraph(const MultiGraph &) override;
         void setVertexSampler(VertexSampler &vertexSampler) { m_vertexSamplerPtr = &vertexSampler; }
         EdgeSampler &getEdgeSampler() { return m_edgeSampler; }
+        void setRNG(RNG &gen) override
+        {
+            EdgeProposer::setRNG(gen);
+            m_edgeSampler.setRNG(gen);
+            if (m_vertexSamplerPtr != nullptr)
+                m_vertexSamplerPtr->setRNG(gen);
+        }
         void applyGraphMove(const GraphMove &move) override;
         // void applyBlockMove(const BlockMove& move) override { };
         const double getLogProposalProbRatio(const GraphMove &move) const override;
@@ -35,9 +35,15 @@ namespace GraphInf
 
         using EdgeProposer::setUpWithGraph;
         const EdgeSampler &getEdgeSampler() const { return m_edgeSampler; }
+        void setRNG(RNG &gen) override
+        {
+            EdgeProposer::setRNG(gen);
+            m_edgeSampler.setRNG(gen);
+        }
         void setDefaultWeights(size_t size)
         {
             m_edgeSampler = EdgeSampler(1, 100);
+            m_edgeSampler.setRNG(*m_rngPtr);
             for (size_t i = 0; i < size; i++)
             {
                 for (size_t j = i + 1; j < size; j++)
@@ -50,6 +56,7 @@ namespace GraphInf
         {
             // weights must be between 1 and 100
             m_edgeSampler = EdgeSampler(1, 100);
+            m_edgeSampler.setRNG(*m_rngPtr);
             for (auto &edge : weights)
             {
                 if (edge.second > 100 || edge.second < 1)
@@ -61,6 +68,7 @@ namespace GraphInf
         {
             // weights must be between 1 and 100
             m_edgeSampler = EdgeSampler(1, 100);
+            m_edgeSampler.setRNG(*m_rngPtr);
             for (size_t i = 0; i < weights.size(); i++)
             {
                 for (size_t j = i + 1; j < weights[i].size(); j++)
@@ -80,7 +88,7 @@ namespace GraphInf
         {
             BaseGraph::Edge potentialEdge = m_edgeSampler.sample();
 
-            if ((m_uniform01(rng) < m_sampleNewEdgeProb) || m_graphPtr->getEdgeMultiplicity(potentialEdge.first, potentialEdge.second) == 0)
+            if ((m_uniform01(*m_rngPtr) < m_sampleNewEdgeProb) || m_graphPtr->getEdgeMultiplicity(potentialEdge.first, potentialEdge.second) == 0)
             {
                 return {{}, {potentialEdge}};
             }
@@ -63,12 +63,12 @@ namespace GraphInf
 
         const LabelMove<Label> proposeMove() const override
         {
-            BaseGraph::VertexIndex vertex = m_vertexDistribution(rng);
+            BaseGraph::VertexIndex vertex = m_vertexDistribution(*this->m_rngPtr);
             return proposeMove(vertex);
         }
         const LabelMove<Label> proposeMove(const BaseGraph::VertexIndex &vertex) const
         {
-            if (m_uniform01(rng) < m_sampleLabelCountProb || m_graphPriorPtr->getLabelCount() == 1)
+            if (m_uniform01(*this->m_rngPtr) < m_sampleLabelCountProb || m_graphPriorPtr->getLabelCount() == 1)
                 return proposeNewLabelMove(vertex);
             LabelMove<Label> move = proposeLabelMove(vertex);
             int maxiter = 10;
@@ -113,7 +113,7 @@ namespace GraphInf
         GibbsLabelProposer(double sampleLabelCountProb = 0.1, double labelCreationProb = 0.5) : LabelProposer<Label>(sampleLabelCountProb), m_labelCreationProb(labelCreationProb) {}
         const LabelMove<Label> proposeNewLabelMove(const BaseGraph::VertexIndex &vertex) const override
         {
-            if (m_uniform01(rng) < m_labelCreationProb)
+            if (m_uniform01(*this->m_rngPtr) < m_labelCreationProb)
                 return {vertex, m_graphPriorPtr->getLabel(vertex), (int)m_graphPriorPtr->getLabelCount(), 1};
             else
                 return {vertex, m_graphPriorPtr->getLabel(vertex), m_graphPriorPtr->getLabel(vertex), -1};
@@ -160,7 +160,7 @@ namespace GraphInf
             if (m_emptyLabels.size() == 0)
                 nextLabel = *m_availableLabels.rbegin() + 1;
             else
-                nextLabel = *sampleUniformlyFrom(m_emptyLabels.begin(), m_emptyLabels.end());
+                nextLabel = *sampleUniformlyFrom(m_emptyLabels.begin(), m_emptyLabels.end(), *this->m_rngPtr);
             LabelMove<Label> move = {vertex, prevLabel, nextLabel};
             if (destroyingLabel(move))
                 return {vertex, prevLabel, prevLabel};
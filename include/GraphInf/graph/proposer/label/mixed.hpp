@@ -18,6 +18,7 @@ namespace GraphInf
     protected:
         double m_shift;
         const VertexLabeledRandomGraph<Label> **m_graphPriorPtrPtr = nullptr;
+        RNG *const *m_rngPtrPtr = nullptr;
         mutable std::uniform_real_distribution<double> m_uniform01 = std::uniform_real_distribution<double>(0, 1);
 
         const Label sampleNeighborLabel(BaseGraph::VertexIndex vertex) const;
@@ -51,7 +52,7 @@ namespace GraphInf
     template <typename Label>
     const Label MixedSampler<Label>::sampleNeighborLabel(BaseGraph::VertexIndex vertex) const
     {
-        BaseGraph::VertexIndex neighbor = sampleRandomNeighbor((*m_graphPriorPtrPtr)->getState(), vertex);
+        BaseGraph::VertexIndex neighbor = sampleRandomNeighbor((*m_graphPriorPtrPtr)->getState(), vertex, true, **m_rngPtrPtr);
         Label label = (*m_graphPriorPtrPtr)->getLabel(neighbor);
         return label;
     }
@@ -59,7 +60,7 @@ namespace GraphInf
     template <typename Label>
     const Label MixedSampler<Label>::sampleLabelFromNeighborLabel(const Label neighborLabel) const
     {
-        return sampleRandomNeighbor((*m_graphPriorPtrPtr)->getLabelGraph(), neighborLabel);
+        return sampleRandomNeighbor((*m_graphPriorPtrPtr)->getLabelGraph(), neighborLabel, true, **m_rngPtrPtr);
     }
 
     template <typename Label>
@@ -73,7 +74,7 @@ namespace GraphInf
         const auto &Et = (*m_graphPriorPtrPtr)->getLabelGraph().getDegree(neighborLabel);
         double probUniformSampling = m_shift * B / (Et + m_shift * B);
         Label nextLabel;
-        if (m_uniform01(rng) < probUniformSampling)
+        if (m_uniform01(**m_rngPtrPtr) < probUniformSampling)
             nextLabel = sampleLabelUniformly();
         else
             nextLabel = sampleLabelFromNeighborLabel(neighborLabel);
@@ -193,7 +194,7 @@ namespace GraphInf
     protected:
         const Label sampleLabelUniformly() const override
         {
-            return std::uniform_int_distribution<size_t>(0, getAvailableLabelCount() - 1)(rng);
+            return std::uniform_int_distribution<size_t>(0, getAvailableLabelCount() - 1)(*this->m_rngPtr);
         }
         const double getLogProposalProbForReverseMove(const LabelMove<Label> &move) const override
         {
@@ -206,7 +207,11 @@ namespace GraphInf
 
     public:
         GibbsMixedLabelProposer(double sampleLabelCountProb = 0.1, double labelCreationProb = 0.5, double shift = 1) : GibbsLabelProposer<Label>(sampleLabelCountProb, labelCreationProb),
-                                                                                                                       MixedSampler<Label>(shift) { this->m_graphPriorPtrPtr = &this->m_graphPriorPtr; }
+                                                                                                                       MixedSampler<Label>(shift)
+        {
+            this->m_graphPriorPtrPtr = &this->m_graphPriorPtr;
+            this->m_rngPtrPtr = &this->m_rngPtr;
+        }
 
         const LabelMove<Label> proposeLabelMove(const BaseGraph::VertexIndex &vertex) const override
         {
@@ -223,7 +228,7 @@ namespace GraphInf
     class RestrictedMixedLabelProposer : public RestrictedLabelProposer<Label>, public MixedSampler<Label>
     {
     protected:
-        const Label sampleLabelUniformly() const override { return *sampleUniformlyFrom(m_availableLabels.begin(), m_availableLabels.end()); }
+        const Label sampleLabelUniformly() const override { return *sampleUniformlyFrom(m_availableLabels.begin(), m_availableLabels.end(), *this->m_rngPtr); }
         const double getLogProposalProbForReverseMove(const LabelMove<Label> &move) const override
         {
             return MixedSampler<Label>::_getLogProposalProbForReverseMove(move);
@@ -239,7 +244,11 @@ namespace GraphInf
 
     public:
         RestrictedMixedLabelProposer(double sampleLabelCountProb = 0.1, double shift = 1) : RestrictedLabelProposer<Label>(sampleLabelCountProb),
-                                                                                            MixedSampler<Label>(shift) { this->m_graphPriorPtrPtr = &this->m_graphPriorPtr; }
+                                                                                            MixedSampler<Label>(shift)
+        {
+            this->m_graphPriorPtrPtr = &this->m_graphPriorPtr;
+            this->m_rngPtrPtr = &this->m_rngPtr;
+        }
 
         const LabelMove<Label> proposeLabelMove(const BaseGraph::VertexIndex &vertex) const override
         {
@@ -23,7 +23,7 @@ namespace GraphInf
         const double getLogProposalProbForReverseMove(const LabelMove<Label> &move) const override { return -log(m_graphPriorPtr->getLabelCount() + move.addedLabels); }
         const LabelMove<Label> proposeLabelMove(const BaseGraph::VertexIndex &vertex) const override
         {
-            Label nextLabel = std::uniform_int_distribution<Label>(0, m_graphPriorPtr->getLabelCount() - 1)(rng);
+            Label nextLabel = std::uniform_int_distribution<Label>(0, m_graphPriorPtr->getLabelCount() - 1)(*this->m_rngPtr);
             return {vertex, m_graphPriorPtr->getLabel(vertex), nextLabel};
         }
     };
@@ -47,7 +47,7 @@ namespace GraphInf
         }
         const LabelMove<Label> proposeLabelMove(const BaseGraph::VertexIndex &vertex) const override
         {
-            Label nextLabel = *sampleUniformlyFrom(m_availableLabels.begin(), m_availableLabels.end());
+            Label nextLabel = *sampleUniformlyFrom(m_availableLabels.begin(), m_availableLabels.end(), *this->m_rngPtr);
             LabelMove<Label> move = {vertex, m_graphPriorPtr->getLabel(vertex), nextLabel};
             move.addedLabels = -(int)RestrictedLabelProposer<Label>::destroyingLabel(move);
             return move;
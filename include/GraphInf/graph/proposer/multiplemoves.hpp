@@ -39,7 +39,7 @@ MultipleMovesProposer<MoveType>::MultipleMovesProposer(std::vector<Proposer<Move
 
 template<typename MoveType>
 const MoveType MultipleMovesProposer<MoveType>::proposeMove() const {
-    m_proposedMoveType = m_moveTypeDistribution(rng);
+    m_proposedMoveType = m_moveTypeDistribution(*this->m_rngPtr);
     return m_proposers[m_proposedMoveType]->proposeMove();
 }
 
@@ -32,7 +32,7 @@ namespace GraphInf
         const Level sampleLevel() const
         {
             std::uniform_int_distribution<Level> dist(0, m_nestedGraphPriorPtr->getDepth() - 1);
-            return dist(rng);
+            return dist(*this->m_rngPtr);
         }
 
         const double getLogProposalProb(const LabelMove<Label> &move, bool reverse = false) const override
@@ -91,7 +91,7 @@ namespace GraphInf
         const LabelMove<Label> proposeNewLabelMove(const BaseGraph::VertexIndex &vertex) const override
         {
             Level level = NestedBaseClass::sampleLevel();
-            if (m_uniform01(rng) < m_labelCreationProb)
+            if (m_uniform01(*this->m_rngPtr) < m_labelCreationProb)
                 return {vertex, m_nestedGraphPriorPtr->getLabel(vertex, level), (int)m_nestedGraphPriorPtr->getNestedLabelCount()[level], 1, level};
             else
                 return {vertex, m_nestedGraphPriorPtr->getLabel(vertex, level), m_nestedGraphPriorPtr->getLabel(vertex, level), -1, level};
@@ -150,7 +150,7 @@ namespace GraphInf
             if (m_emptyLabels[level].size() == 0)
                 nextLabel = *m_availableLabels[level].rbegin() + 1;
             else
-                nextLabel = *sampleUniformlyFrom(m_emptyLabels[level].begin(), m_emptyLabels[level].end());
+                nextLabel = *sampleUniformlyFrom(m_emptyLabels[level].begin(), m_emptyLabels[level].end(), *this->m_rngPtr);
             LabelMove<Label> move = {vertex, prevLabel, nextLabel, 1, level};
             if (destroyingLabel(move))
                 return {vertex, prevLabel, prevLabel, 0, level};
@@ -18,6 +18,7 @@ namespace GraphInf
     protected:
         double m_shift;
         const NestedVertexLabeledRandomGraph<Label> **m_nestedGraphPriorPtrPtr = nullptr;
+        RNG *const *m_rngPtrPtr = nullptr;
         mutable std::uniform_real_distribution<double> m_uniform01 = std::uniform_real_distribution<double>(0, 1);
         //
         const Label sampleNeighborLabelAtLevel(BaseGraph::VertexIndex vertex, Level level) const;
@@ -51,7 +52,7 @@ namespace GraphInf
         const Label index = (*m_nestedGraphPriorPtrPtr)->getLabel(vertex, level - 1);
         const LabelGraph &graph = (*m_nestedGraphPriorPtrPtr)->getNestedLabelGraph(level - 1);
 
-        Label neighbor = sampleRandomNeighbor(graph, index);
+        Label neighbor = sampleRandomNeighbor(graph, index, true, **m_rngPtrPtr);
         Label label = (*m_nestedGraphPriorPtrPtr)->getNestedLabel(neighbor, level);
         return label;
     }
@@ -60,7 +61,7 @@ namespace GraphInf
     const Label MixedNestedSampler<Label>::sampleLabelFromNeighborLabelAtLevel(
         const Label neighborLabel, Level level) const
     {
-        return sampleRandomNeighbor((*m_nestedGraphPriorPtrPtr)->getNestedLabelGraph(level), neighborLabel);
+        return sampleRandomNeighbor((*m_nestedGraphPriorPtrPtr)->getNestedLabelGraph(level), neighborLabel, true, **m_rngPtrPtr);
     }
     //
     template <typename Label>
@@ -77,7 +78,7 @@ namespace GraphInf
             const auto &Et = (*m_nestedGraphPriorPtrPtr)->getNestedLabelGraph(level).getDegree(neighborLabel);
             double probUniformSampling = m_shift * B / (Et + m_shift * B);
             probUniformSampling = 0;
-            if (m_uniform01(rng) < probUniformSampling)
+            if (m_uniform01(**m_rngPtrPtr) < probUniformSampling)
             {
                 nextLabel = sampleLabelUniformlyAtLevel(level);
             }
@@ -209,7 +210,7 @@ namespace GraphInf
     protected:
         const Label sampleLabelUniformlyAtLevel(Level level) const override
         {
-            return std::uniform_int_distribution<size_t>(0, getAvailableLabelCountAtLevel(level) - 2)(rng);
+            return std::uniform_int_distribution<size_t>(0, getAvailableLabelCountAtLevel(level) - 2)(*this->m_rngPtr);
         }
         const size_t getAvailableLabelCountAtLevel(Level level) const override
         {
@@ -233,7 +234,11 @@ namespace GraphInf
         using MixedNestedSampler<Label>::_getLogProposalProbForReverseMove;
 
         GibbsMixedNestedLabelProposer(double sampleLabelCountProb = 0.5, double labelCreationProb = 0.1, double shift = 1) : GibbsNestedLabelProposer<Label>(sampleLabelCountProb, labelCreationProb),
-                                                                                                                             MixedNestedSampler<Label>(shift) { m_nestedGraphPriorPtrPtr = &m_nestedGraphPriorPtr; }
+                                                                                                                             MixedNestedSampler<Label>(shift)
+        {
+            m_nestedGraphPriorPtrPtr = &m_nestedGraphPriorPtr;
+            this->m_rngPtrPtr = &this->m_rngPtr;
+        }
 
         const LabelMove<Label> proposeLabelMove(const BaseGraph::VertexIndex &vertex) const override
         {
@@ -250,7 +255,7 @@ namespace GraphInf
     protected:
         const Label sampleLabelUniformlyAtLevel(Level level) const override
         {
-            return *sampleUniformlyFrom(m_availableLabels[level].begin(), m_availableLabels[level].end());
+            return *sampleUniformlyFrom(m_availableLabels[level].begin(), m_availableLabels[level].end(), *this->m_rngPtr);
         }
         const size_t getAvailableLabelCountAtLevel(Level level) const override
         {
@@ -276,7 +281,11 @@ namespace GraphInf
         using MixedNestedSampler<Label>::_getLogProposalProbForMove;
         using MixedNestedSampler<Label>::_getLogProposalProbForReverseMove;
         RestrictedMixedNestedLabelProposer(double sampleLabelCountProb = 0.5, double shift = 1) : RestrictedNestedLabelProposer<Label>(sampleLabelCountProb),
-                                                                                                  MixedNestedSampler<Label>(shift) { m_nestedGraphPriorPtrPtr = &m_nestedGraphPriorPtr; }
+                                                                                                  MixedNestedSampler<Label>(shift)
+        {
+            m_nestedGraphPriorPtrPtr = &m_nestedGraphPriorPtr;
+            this->m_rngPtrPtr = &this->m_rngPtr;
+        }
 
         const LabelMove<Label> proposeLabelMove(const BaseGraph::VertexIndex &vertex) const override
         {
@@ -29,7 +29,7 @@ namespace GraphInf
             if (m_nestedGraphPriorPtr->getNestedLabelCount()[level] == 1)
                 nextLabel = 0;
             else
-                nextLabel = std::uniform_int_distribution<Label>(0, m_nestedGraphPriorPtr->getNestedLabelCount()[level] - 1)(rng);
+                nextLabel = std::uniform_int_distribution<Label>(0, m_nestedGraphPriorPtr->getNestedLabelCount()[level] - 1)(*this->m_rngPtr);
             return {vertex, m_nestedGraphPriorPtr->getLabel(vertex, level), nextLabel, 0, level};
         }
     };
@@ -58,7 +58,7 @@ namespace GraphInf
         const LabelMove<Label> proposeLabelMove(const BaseGraph::VertexIndex &vertex) const override
         {
             Level level = sampleLevel();
-            Label nextLabel = *sampleUniformlyFrom(m_availableLabels[level].begin(), m_availableLabels[level].end());
+            Label nextLabel = *sampleUniformlyFrom(m_availableLabels[level].begin(), m_availableLabels[level].end(), *this->m_rngPtr);
             LabelMove<Label> move = {vertex, m_nestedGraphPriorPtr->getLabel(vertex, level), nextLabel, 0, level};
             move.addedLabels = -(int)RestrictedNestedLabelProposer<Label>::destroyingLabel(move);
             return move;
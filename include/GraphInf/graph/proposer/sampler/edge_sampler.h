@@ -21,16 +21,17 @@ namespace GraphInf
         sset::SamplableSet<BaseGraph::Edge> m_edgeSampler;
         std::unordered_map<BaseGraph::Edge, double> m_hiddenWeights;
         const MultiGraph *m_graphPtr = nullptr;
+        RNG *m_rngPtr = &rng;
 
     public:
         EdgeSampler(double minWeight = 1, double maxWeight = 100) : m_minWeight(minWeight), m_maxWeight(maxWeight),
                                                                     m_edgeSampler(minWeight, maxWeight) {}
-        EdgeSampler(const EdgeSampler &other) : m_edgeSampler(other.m_edgeSampler), m_hiddenWeights(other.m_hiddenWeights) {}
+        EdgeSampler(const EdgeSampler &other) : m_edgeSampler(other.m_edgeSampler), m_hiddenWeights(other.m_hiddenWeights), m_rngPtr(other.m_rngPtr) {}
         virtual ~EdgeSampler() {}
 
         BaseGraph::Edge sample() const
         {
-            return m_edgeSampler.sample_ext_RNG(rng).first;
+            return m_edgeSampler.sample_ext_RNG(*m_rngPtr).first;
         }
         bool contains(const BaseGraph::Edge &edge) const
         {
@@ -68,6 +69,7 @@ namespace GraphInf
         bool isEmpty() const { return m_edgeSampler.size() == 0; }
         void setUpWithGraph(const MultiGraph &graph);
 
+        void setRNG(RNG &gen) { m_rngPtr = &gen; }
         void clear() { m_edgeSampler.clear(); }
         void checkSafety() const {}
     };
@@ -17,6 +17,9 @@ namespace GraphInf
 
     class VertexSampler
     {
+    protected:
+        RNG *m_rngPtr = &rng;
+
     public:
         virtual ~VertexSampler() {}
         virtual BaseGraph::VertexIndex sample() const = 0;
@@ -37,6 +40,7 @@ namespace GraphInf
         virtual void checkSafety() const {}
         virtual void clear() {}
         virtual void setUpWithGraph(const MultiGraph &graph);
+        virtual void setRNG(RNG &gen) { m_rngPtr = &gen; }
     };
 
     class VertexUniformSampler : public VertexSampler
@@ -46,15 +50,16 @@ namespace GraphInf
 
     public:
         VertexUniformSampler(double minWeight = 1, double maxWeight = 100) : m_vertexSampler(minWeight, maxWeight) {}
-        VertexUniformSampler(const VertexUniformSampler &other) : m_vertexSampler(other.m_vertexSampler) {}
+        VertexUniformSampler(const VertexUniformSampler &other) : m_vertexSampler(other.m_vertexSampler) { m_rngPtr = other.m_rngPtr; }
         virtual ~VertexUniformSampler() {}
         const VertexUniformSampler &operator=(const VertexUniformSampler &other)
         {
             m_vertexSampler = other.m_vertexSampler;
+            m_rngPtr = other.m_rngPtr;
             return *this;
         }
 
-        BaseGraph::VertexIndex sample() const override { return m_vertexSampler.sample_ext_RNG(rng).first; }
+        BaseGraph::VertexIndex sample() const override { return m_vertexSampler.sample_ext_RNG(*m_rngPtr).first; }
 
         bool contains(const BaseGraph::VertexIndex &vertex) const override
         {
@@ -106,7 +111,7 @@ namespace GraphInf
         VertexDegreeSampler(double shift = 1, double minWeight = 1, double maxWeight = 100) : m_shift(shift), m_edgeSampler(minWeight, maxWeight),
                                                                                               m_vertexSampler(minWeight, maxWeight) {};
         VertexDegreeSampler(const VertexDegreeSampler &other) : m_vertexSampler(other.m_vertexSampler), m_edgeSampler(other.m_edgeSampler),
-                                                                m_totalEdgeWeight(other.m_totalEdgeWeight), m_shift(other.m_shift) {}
+                                                                m_totalEdgeWeight(other.m_totalEdgeWeight), m_shift(other.m_shift) { m_rngPtr = other.m_rngPtr; }
         ~VertexDegreeSampler() {}
         const VertexDegreeSampler &operator=(const VertexDegreeSampler &other)
         {
@@ -115,6 +120,7 @@ namespace GraphInf
             this->m_totalEdgeWeight = other.m_totalEdgeWeight;
             this->m_weights = other.m_weights;
             this->m_shift = other.m_shift;
+            this->m_rngPtr = other.m_rngPtr;
             return *this;
         }
 
@@ -153,6 +159,11 @@ namespace GraphInf
         }
 
         void setUpWithGraph(const MultiGraph &graph) override;
+        void setRNG(RNG &gen) override
+        {
+            VertexSampler::setRNG(gen);
+            m_edgeSampler.setRNG(gen);
+        }
     };
 
 } /* GraphInf */
@@ -8,6 +8,7 @@
 #include "GraphInf/exceptions.h"
 #include "GraphInf/mcmc.h"
 #include "GraphInf/utility/maps.hpp"
+#include "GraphInf/utility/parallel.hpp"
 #include "GraphInf/mcmc.h"
 #include "GraphInf/graph/likelihood/likelihood.hpp"
 #include "GraphInf/graph/prior/edge_count.h"
@@ -43,6 +44,7 @@ namespace GraphInf
         bool m_withSelfLoops, m_withParallelEdges;
         size_t m_size;
         MultiGraph m_state;
+        LazyThreadPool m_threadPool;
         virtual void _applyGraphMove(const GraphMove &);
         void _applyGraphMoveToProposers(const GraphMove &move)
         {
@@ -65,7 +67,7 @@ namespace GraphInf
 
         GraphMove proposeCanonicalMove() const
         {
-            auto s = m_canonicalProposer(rng);
+            auto s = m_canonicalProposer(*m_rngPtr);
             if (s == 2 && getEdgeCount() > 2)
                 return m_doubleEdgeSwapProposer.proposeMove();
             if (s == 1 && getEdgeCount() > 1)
@@ -75,7 +77,7 @@ namespace GraphInf
 
         GraphMove proposeMicrocanonicalMove() const
         {
-            auto s = m_microcanonicalProposer(rng);
+            auto s = m_microcanonicalProposer(*m_rngPtr);
             if (s == 1 && getEdgeCount() > 2)
                 return m_doubleEdgeSwapProposer.proposeMove();
             if (getEdgeCount() > 1)
@@ -231,7 +233,7 @@ namespace GraphInf
             double logProposalRatio = getLogProposalRatioFromGraphMove(move);
             double logAcceptanceRatio = logJointRatio + logProposalRatio;
             bool accepted = false;
-            if (logAcceptanceRatio >= 0 or m_uniform01(rng) < exp(logAcceptanceRatio))
+            if (logAcceptanceRatio >= 0 or m_uniform01(*m_rngPtr) < exp(logAcceptanceRatio))
             {
                 accepted = true;
                 applyGraphMove(move);
@@ -240,19 +242,20 @@ namespace GraphInf
         }
         virtual const StepResult<GraphMove> greedyGraphStep(size_t nCandidates = 1)
         {
+            std::vector<GraphMove> moves;
+            for (size_t i = 0; i < nCandidates; i++)
+                moves.push_back(proposeGraphMove());
+            const auto logJointRatios = getLogJointRatiosFromGraphMoves(moves);
+
+            // The first best candidate wins, whatever the thread count.
             double bestLogJointRatio = -INFINITY;
             GraphMove bestMove;
-            bool accepted = false;
             for (size_t i = 0; i < nCandidates; i++)
             {
-                GraphMove move = proposeGraphMove();
-                double logJointRatio = getLogJointRatioFromGraphMove(move);
-
-                if (isValidGraphMove(move) && logJointRatio > bestLogJointRatio)
+                if (isValidGraphMove(moves[i]) && logJointRatios[i] > bestLogJointRatio)
                 {
-                    bestMove = move;
-                    bestLogJointRatio = logJointRatio;
-                    accepted = true;
+                    bestMove = moves[i];
+                    bestLogJointRatio = logJointRatios[i];
                 }
             }
             applyGraphMove(bestMove);
@@ -295,6 +298,13 @@ namespace GraphInf
             return summary;
         }
 
+        /* Thread safety: the const log-likelihood, log-prior and log-joint
+         * methods, the log-ratio methods of graph and label moves (proposal
+         * ratios included), `isValid...Move` and `checkConsistency` only read
+         * the model. Any number of threads can call them at once, as long as no
+         * thread modifies the model meanwhile. Proposing a move draws from the
+         * model's RNG and is not thread-safe, nor are methods overridden in
+         * Python. */
         const double getLogLikelihood() const
         {
             return m_likelihoodModelPtr->getLogLikelihood();
@@ -323,6 +333,21 @@ namespace GraphInf
         {
             return getLogPriorRatioFromGraphMove(move) + getLogLikelihoodRatioFromGraphMove(move);
         }
+        /* Log joint ratios of `moves` from the current state, computed
+         * concurrently (see `setThreadCount`). */
+        const std::vector<double> getLogJointRatiosFromGraphMoves(const std::vector<GraphMove> &moves) const
+        {
+            std::vector<double> logJointRatios(moves.size());
+            m_threadPool.get().parallelFor(moves.size(), [&](size_t i)
+                                           { logJointRatios[i] = getLogJointRatioFromGraphMove(moves[i]); });
+            return logJointRatios;
+        }
+
+        /* Threads used to score the candidates of greedy steps (0 means one
+         * per hardware thread). Models overriding the ratio methods from
+         * Python must keep a single thread. */
+        void setThreadCount(size_t threadCount) { m_threadPool.setThreadCount(threadCount); }
+        const size_t getThreadCount() const { return m_threadPool.getThreadCount(); }
 
         void applyGraphMove(const GraphMove &move);
         const GraphMove proposeGraphMove() const;
@@ -344,6 +369,20 @@ namespace GraphInf
         }
 
         virtual bool isValidGraphMove(const GraphMove &move) const { return true; }
+
+        /* Makes the model, its priors, likelihood and proposers draw from `gen`.
+         * Components attached after this call still use their own generator. */
+        virtual void setRNG(RNG &gen) override
+        {
+            NestedRandomVariable::setRNG(gen);
+            m_singleEdgeProposer.setRNG(gen);
+            m_hingeFlipProposer.setRNG(gen);
+            m_doubleEdgeSwapProposer.setRNG(gen);
+            if (m_edgeCountPriorPtr)
+                m_edgeCountPriorPtr->setRNG(gen);
+            if (m_likelihoodModelPtr)
+                m_likelihoodModelPtr->setRNG(gen);
+        }
     };
 
     template <typename Label>
@@ -383,6 +422,7 @@ namespace GraphInf
         void setLabelProposer(LabelProposer<Label> &proposer)
         {
             proposer.isRoot(false);
+            proposer.setRNG(*this->m_rngPtr);
             m_labelProposerPtr = &proposer;
         }
         const LabelProposer<Label> &getLabelProposer() const
@@ -436,7 +476,7 @@ namespace GraphInf
 
             // Metropolis-Hastings step
             bool accepted = false;
-            if (m_uniform(rng) < acceptProb)
+            if (m_uniform(*this->m_rngPtr) < acceptProb)
             {
                 applyLabelMove(move);
                 accepted = true;
@@ -444,20 +484,30 @@ namespace GraphInf
             return {move, logLikelihoodRatio + logPriorRatio + logProposalRatio, accepted};
         }
 
+        const std::vector<double> getLogJointRatiosFromLabelMoves(const std::vector<LabelMove<Label>> &moves) const
+        {
+            std::vector<double> logJointRatios(moves.size());
+            this->m_threadPool.get().parallelFor(moves.size(), [&](size_t i)
+                                                 { logJointRatios[i] = getLogJointRatioFromLabelMove(moves[i]); });
+            return logJointRatios;
+        }
+
         const StepResult<LabelMove<Label>> greedyParamStep(size_t nCandidates) override
         {
+            std::vector<LabelMove<Label>> moves;
+            for (size_t i = 1; i < nCandidates; i++)
+                moves.push_back(proposeLabelMove());
+            const auto logJointRatios = getLogJointRatiosFromLabelMoves(moves);
+
             LabelMove<Label> bestMove;
             double bestLogJointRatio = 0;
             bool accepted = false;
-
-            for (size_t i = 1; i < nCandidates; i++)
+            for (size_t i = 0; i < moves.size(); i++)
             {
-                auto move = proposeLabelMove();
-                auto logJointRatio = getLogJointRatioFromLabelMove(move);
-                if (logJointRatio > bestLogJointRatio && isValidLabelMove(move))
+                if (logJointRatios[i] > bestLogJointRatio && isValidLabelMove(moves[i]))
                 {
-                    bestMove = move;
-                    bestLogJointRatio = logJointRatio;
+                    bestMove = moves[i];
+                    bestLogJointRatio = logJointRatios[i];
                     accepted = true;
                 }
             }
@@ -480,6 +530,12 @@ namespace GraphInf
             m_labelProposerPtr->checkConsistency();
         }
         virtual void reduceLabels() {}
+        virtual void setRNG(RNG &gen) override
+        {
+            RandomGraph::setRNG(gen);
+            if (m_labelProposerPtr)
+                m_labelProposerPtr->setRNG(gen);
+        }
     };
 
     using BlockLabeledRandomGraph = VertexLabeledRandomGraph<BlockIndex>;
@@ -520,6 +576,7 @@ namespace GraphInf
         void setNestedLabelProposer(NestedLabelProposer<Label> &proposer)
         {
             proposer.isRoot(false);
+            proposer.setRNG(*this->m_rngPtr);
             m_labelProposerPtr = &proposer;
             m_nestedLabelProposerPtr = &proposer;
         }
@@ -130,9 +130,15 @@ namespace GraphInf
         }
         void computationFinished() const override
         {
-            m_isProcessed = false;
+            NestedRandomVariable::computationFinished();
             m_labelGraphPriorPtr->computationFinished();
         }
+        void setRNG(RNG &gen) override
+        {
+            VertexLabeledRandomGraph<BlockIndex>::setRNG(gen);
+            if (m_labelGraphPriorPtr)
+                m_labelGraphPriorPtr->setRNG(gen);
+        }
         void checkSelfSafety() const override
         {
             RandomGraph::checkSelfSafety();
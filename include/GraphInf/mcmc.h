@@ -1,6 +1,10 @@
 #ifndef GRAPHINF_UTIL_MCMC_H
 #define GRAPHINF_UTIL_MCMC_H
 
+#include <array>
+#include <cstdint>
+#include <map>
+#include <mutex>
 #include <string>
 #include <vector>
 #include <iostream>
@@ -9,30 +13,55 @@
 #include "BaseGraph/types.h"
 #include "GraphInf/types.h"
 #include "GraphInf/utility/maps.hpp"
+#include "GraphInf/utility/small_vector.hpp"
 
 namespace GraphInf
 {
+    /* Kinds of moves counted by `MCMCSummary`. `Count` is the number of kinds. */
+    enum class MoveKind : unsigned char
+    {
+        None,
+        Removed,
+        Added,
+        HingeFlip,
+        DoubleEdgeFlip,
+        MultiFlip,
+        LabelSwap,
+        Param,
+        Count
+    };
+
+    inline const char *getMoveKindName(MoveKind kind)
+    {
+        static const char *names[] = {"none", "removed", "added", "hinge_flip", "double_edge_flip", "multiflip", "label_swap", "param"};
+        return names[static_cast<size_t>(kind)];
+    }
+
+    // Edges of a move, stored inline up to the two edges of a double edge swap.
+    typedef SmallVector<BaseGraph::Edge, 2> EdgeList;
+
     struct GraphMove
     {
-        GraphMove(std::vector<BaseGraph::Edge> removedEdges, std::vector<BaseGraph::Edge> addedEdges) : removedEdges(removedEdges), addedEdges(addedEdges) {}
+        GraphMove(EdgeList removedEdges, EdgeList addedEdges) : removedEdges(removedEdges), addedEdges(addedEdges) {}
         GraphMove() {}
-        std::vector<BaseGraph::Edge> removedEdges;
-        std::vector<BaseGraph::Edge> addedEdges;
+        EdgeList removedEdges;
+        EdgeList addedEdges;
 
-        std::string alias() const
+        MoveKind kind() const
         {
             if (removedEdges.size() == 0 and addedEdges.size() == 0)
-                return "none";
+                return MoveKind::None;
             if (removedEdges.size() == 1 and addedEdges.size() == 0)
-                return "removed";
+                return MoveKind::Removed;
             if (removedEdges.size() == 0 and addedEdges.size() == 1)
-                return "added";
+                return MoveKind::Added;
             if (removedEdges.size() == 1 and addedEdges.size() == 1)
-                return "hinge_flip";
+                return MoveKind::HingeFlip;
             if (removedEdges.size() == 2 and addedEdges.size() == 2)
-                return "double_edge_flip";
-            return "multiflip";
+                return MoveKind::DoubleEdgeFlip;
+            return MoveKind::MultiFlip;
         }
+        std::string alias() const { return getMoveKindName(kind()); }
 
         friend std::ostream &operator<<(std::ostream &os, const GraphMove &move)
         {
@@ -62,13 +91,54 @@ namespace GraphInf
         }
     };
 
+    /* Process-wide indices of the parameter keys, so that parameter moves
+     * can be counted without string work. A key is registered once, when its
+     * proposer is set up; the lock is only taken then and when reading. */
+    class ParamKeyRegistry
+    {
+        static std::mutex &getMutex()
+        {
+            static std::mutex mutex;
+            return mutex;
+        }
+        static std::vector<std::string> &getKeyList()
+        {
+            static std::vector<std::string> keys;
+            return keys;
+        }
+
+    public:
+        static const size_t NONE = SIZE_MAX;
+
+        static size_t getIndex(const std::string &key)
+        {
+            std::lock_guard<std::mutex> lock(getMutex());
+            auto &keys = getKeyList();
+            for (size_t i = 0; i < keys.size(); i++)
+                if (keys[i] == key)
+                    return i;
+            keys.push_back(key);
+            return keys.size() - 1;
+        }
+        static std::vector<std::string> getKeys()
+        {
+            std::lock_guard<std::mutex> lock(getMutex());
+            return getKeyList();
+        }
+    };
+
     struct ParamMove
     {
-        ParamMove(std::string key = "none", double value = 0.0) : key(key), value(value) {}
+        ParamMove(std::string key = "none", double value = 0.0, size_t keyIndex = ParamKeyRegistry::NONE)
+            : key(key), value(value), keyIndex(keyIndex) {}
 
         std::string key;
         double value;
+        /* Index of `key` in `ParamKeyRegistry`, set by the proposers; moves
+         * built without it are registered when counted. */
+        size_t keyIndex;
 
+        MoveKind kind() const { return MoveKind::Param; }
         std::string alias() const
         {
             return "param[" + key + "]";
@@ -100,10 +170,8 @@ namespace GraphInf
         int addedLabels;
         Level level;
 
-        std::string alias() const
-        {
-            return "label_swap";
-        }
+        MoveKind kind() const { return MoveKind::LabelSwap; }
+        std::string alias() const { return getMoveKindName(kind()); }
 
         friend std::ostream &operator<<(std::ostream &os, const LabelMove<Label> &move)
         {
@@ -142,63 +210,124 @@ namespace GraphInf
         }
     };
 
+    /* Counts of proposed and accepted moves. Counters are indexed by
+     * `MoveKind`, and parameter moves are further broken down by their index
+     * in `ParamKeyRegistry`, so that `update` does no string work; the
+     * aliases of `getTotal`/`getAccepted` are only built when read. */
     struct MCMCSummary
     {
-        std::map<std::string, size_t> total, accepted;
+        static const size_t MOVE_KIND_COUNT = static_cast<size_t>(MoveKind::Count);
+        typedef std::array<size_t, MOVE_KIND_COUNT> MoveCounts;
+
+        MoveCounts totalCounts, acceptedCounts;
+        std::vector<size_t> paramTotalCounts, paramAcceptedCounts;
         double logJointRatio;
 
-        MCMCSummary(double logJointRatio = 0.0) : logJointRatio(logJointRatio) {}
+        MCMCSummary(double logJointRatio = 0.0) : logJointRatio(logJointRatio)
+        {
+            totalCounts.fill(0);
+            acceptedCounts.fill(0);
+        }
 
         template <typename MoveType>
         void update(const StepResult<MoveType> &step)
         {
+            const size_t kind = static_cast<size_t>(step.move.kind());
+            totalCounts[kind]++;
             if (step.accepted)
             {
                 logJointRatio += step.logJointRatio;
-                if (accepted.count(step.move.alias()) == 0)
-                    accepted[step.move.alias()] = 1;
-                else
-                    accepted[step.move.alias()]++;
+                acceptedCounts[kind]++;
             }
-            if (total.count(step.move.alias()) == 0)
-                total[step.move.alias()] = 1;
-            else
-                total[step.move.alias()]++;
+            updateParamCounts(step.move, step.accepted);
         }
         void join(const MCMCSummary &other)
         {
             logJointRatio += other.logJointRatio;
-            for (auto &a : other.accepted)
+            for (size_t k = 0; k < MOVE_KIND_COUNT; k++)
             {
-                if (accepted.count(a.first) == 0)
-                    accepted[a.first] = a.second;
-                else
-                    accepted[a.first] += a.second;
+                totalCounts[k] += other.totalCounts[k];
+                acceptedCounts[k] += other.acceptedCounts[k];
             }
-            for (auto &t : other.total)
+            reserveParamCounts(other.paramTotalCounts.size());
+            for (size_t i = 0; i < other.paramTotalCounts.size(); i++)
             {
-                if (total.count(t.first) == 0)
-                    total[t.first] = t.second;
-                else
-                    total[t.first] += t.second;
+                paramTotalCounts[i] += other.paramTotalCounts[i];
+                paramAcceptedCounts[i] += other.paramAcceptedCounts[i];
             }
         }
+
+        size_t getTotalCount(MoveKind kind) const { return totalCounts[static_cast<size_t>(kind)]; }
+        size_t getAcceptedCount(MoveKind kind) const { return acceptedCounts[static_cast<size_t>(kind)]; }
+        size_t getTotalCount() const
+        {
+            size_t count = 0;
+            for (auto c : totalCounts)
+                count += c;
+            return count;
+        }
+        size_t getAcceptedCount() const
+        {
+            size_t count = 0;
+            for (auto c : acceptedCounts)
+                count += c;
+            return count;
+        }
+
+        /* Counts by move alias, only for the aliases that were proposed. */
+        std::map<std::string, size_t> getTotal() const { return getCountsByAlias(totalCounts, paramTotalCounts, totalCounts, paramTotalCounts); }
+        std::map<std::string, size_t> getAccepted() const { return getCountsByAlias(acceptedCounts, paramAcceptedCounts, totalCounts, paramTotalCounts); }
+
         std::string display() const
         {
             std::stringstream ss;
             ss << "MCMCSummary(log_joint_ratio=" << logJointRatio << ", accepted={";
-            for (auto &a : accepted)
+            for (auto &a : getAccepted())
             {
                 ss << a.first << ": " << a.second << ", ";
             }
             ss << "}, total={";
-            for (auto &t : total)
+            for (auto &t : getTotal())
             {
                 ss << t.first << ": " << t.second << ", ";
             }
             ss << "})";
             return ss.str();
         }
+
+    private:
+        template <typename MoveType>
+        void updateParamCounts(const MoveType &, bool) {}
+        void updateParamCounts(const ParamMove &move, bool accepted)
+        {
+            const size_t index = (move.keyIndex != ParamKeyRegistry::NONE) ? move.keyIndex : ParamKeyRegistry::getIndex(move.key);
+            reserveParamCounts(index + 1);
+            paramTotalCounts[index]++;
+            paramAcceptedCounts[index] += accepted;
+        }
+        void reserveParamCounts(size_t numKeys)
+        {
+            if (paramTotalCounts.size() >= numKeys)
+                return;
+            paramTotalCounts.resize(numKeys, 0);
+            paramAcceptedCounts.resize(numKeys, 0);
+        }
+
+        static std::map<std::string, size_t> getCountsByAlias(const MoveCounts &counts, const std::vector<size_t> &paramCounts,
+                                                              const MoveCounts &proposed, const std::vector<size_t> &paramProposed)
+        {
+            std::map<std::string, size_t> countsByAlias;
+            for (size_t k = 0; k < MOVE_KIND_COUNT; k++)
+                if (static_cast<MoveKind>(k) != MoveKind::Param and proposed[k] > 0)
+                    countsByAlias[getMoveKindName(static_cast<MoveKind>(k))] = counts[k];
+            if (paramProposed.empty())
+                return countsByAlias;
+            const auto keys = ParamKeyRegistry::getKeys();
+            for (size_t i = 0; i < paramProposed.size(); i++)
+                if (paramProposed[i] > 0)
+                    countsByAlias["param[" + keys[i] + "]"] = paramCounts[i];
+            return countsByAlias;
+        }
     };
 
     using BlockMove = LabelMove<BlockIndex>;
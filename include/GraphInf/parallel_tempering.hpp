@@ -0,0 +1,227 @@
+#ifndef GRAPH_INF_PARALLEL_TEMPERING_HPP
+#define GRAPH_INF_PARALLEL_TEMPERING_HPP
+
+#include <cmath>
+#include <random>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "GraphInf/mcmc.h"
+#include "GraphInf/rng.h"
+#include "GraphInf/utility/parallel.hpp"
+
+namespace GraphInf
+{
+
+    struct SwapStatistics
+    {
+        size_t attempted = 0;
+        size_t accepted = 0;
+
+        double getAcceptanceRate() const { return (attempted > 0) ? (double)accepted / attempted : 0; }
+    };
+
+    /* Replica-exchange MCMC over the likelihood temperature.
+     *
+     * Replica `r` is built by the factory and owns the stream
+     * `makeRNGStream(masterSeed, r)`; swaps use the stream of index
+     * `getReplicaCount()`. Level `l` of the ladder runs at `betaLikelihood =
+     * getBetas()[l]`, level 0 being the target distribution. Every round, each
+     * level performs a Metropolis sweep on its own thread, then swaps are
+     * attempted between all adjacent levels (even pairs first, then odd ones).
+     * Swapping exchanges temperatures, not states, so no model is ever copied.
+     *
+     * The ladder can be adapted during the first rounds so that all adjacent
+     * pairs reach the same swap acceptance, while the two ends stay fixed (see
+     * `setAdaptation`). The chain is only guaranteed to target the posterior
+     * once adaptation has stopped. */
+    template <typename Model>
+    class ParallelTempering
+    {
+    public:
+        typedef std::function<std::shared_ptr<Model>(size_t replicaIndex)> ModelFactory;
+        typedef std::function<void(size_t round, const Model &model, const MCMCSummary &summary)> SampleSink;
+
+    private:
+        std::vector<std::shared_ptr<Model>> m_replicas;
+        std::vector<RNG> m_streams;
+        std::vector<double> m_betas;
+        std::vector<size_t> m_replicaAtLevel;
+        std::vector<double> m_logLikelihoods;
+        std::vector<SwapStatistics> m_swapStatistics;
+        std::vector<double> m_lastSwapProbs;
+        SampleSink m_sink = nullptr;
+        double m_betaPrior;
+        size_t m_threadCount;
+        size_t m_round = 0;
+
+        size_t m_adaptationRounds = 0;
+        double m_adaptationRate = 1, m_adaptationLag = 100;
+
+        void attemptSwap(size_t level)
+        {
+            size_t &cold = m_replicaAtLevel[level], &hot = m_replicaAtLevel[level + 1];
+            double logSwapProb = (m_betas[level] - m_betas[level + 1]) * (m_logLikelihoods[hot] - m_logLikelihoods[cold]);
+            double swapProb = (logSwapProb >= 0) ? 1 : std::exp(logSwapProb);
+            if (std::isnan(swapProb))
+                swapProb = 0;
+
+            m_lastSwapProbs[level] = swapProb;
+            m_swapStatistics[level].attempted++;
+            if (std::uniform_real_distribution<double>(0, 1)(m_streams.back()) < swapProb)
+            {
+                std::swap(cold, hot);
+                m_swapStatistics[level].accepted++;
+            }
+        }
+
+        /* Stochastic approximation on the log-gaps between adjacent betas: gaps
+         * whose swaps are accepted more often than the average are widened, the
+         * others are narrowed, and the gaps are rescaled to keep both ends. */
+        void adaptLadder()
+        {
+            const size_t pairCount = m_lastSwapProbs.size();
+            double meanSwapProb = 0;
+            for (auto p : m_lastSwapProbs)
+                meanSwapProb += p / pairCount;
+
+            double rate = m_adaptationRate * m_adaptationLag / (m_round + m_adaptationLag);
+            std::vector<double> gaps(pairCount);
+            double gapSum = 0;
+            for (size_t l = 0; l < pairCount; l++)
+            {
+                gaps[l] = (m_betas[l] - m_betas[l + 1]) * std::exp(rate * (m_lastSwapProbs[l] - meanSwapProb));
+                gapSum += gaps[l];
+            }
+
+            double span = m_betas.front() - m_betas.back();
+            for (size_t l = 0; l + 1 < pairCount; l++)
+                m_betas[l + 1] = m_betas[l] - gaps[l] * span / gapSum;
+        }
+
+    public:
+        ParallelTempering(const ModelFactory &factory, const std::vector<double> &betas, size_t masterSeed = getSeed(),
+                          double betaPrior = 1, size_t threadCount = 0) : m_streams(makeRNGStreams(masterSeed, betas.size() + 1)),
+                                                                          m_betas(betas),
+                                                                          m_logLikelihoods(betas.size()),
+                                                                          m_swapStatistics(betas.size() - (betas.size() > 0)),
+                                                                          m_lastSwapProbs(betas.size() - (betas.size() > 0)),
+                                                                          m_betaPrior(betaPrior)
+        {
+            if (betas.size() == 0)
+                throw std::invalid_argument("ParallelTempering: `betas` must not be empty.");
+            for (size_t l = 0; l < betas.size(); l++)
+            {
+                if (betas[l] < 0)
+                    throw std::invalid_argument("ParallelTempering: `betas` must be non-negative.");
+                if (l > 0 and betas[l] >= betas[l - 1])
+                    throw std::invalid_argument("ParallelTempering: `betas` must be strictly decreasing.");
+            }
+            setThreadCount(threadCount);
+
+            for (size_t r = 0; r < betas.size(); r++)
+            {
+                m_replicas.push_back(factory(r));
+                if (not m_replicas.back())
+                    throw std::invalid_argument("ParallelTempering: factory returned a null model for replica " + std::to_string(r) + ".");
+                m_replicas.back()->setRNG(m_streams[r]);
+                m_replicaAtLevel.push_back(r);
+                m_logLikelihoods[r] = m_replicas.back()->getLogLikelihood();
+            }
+        }
+        // The replicas point into `m_streams`, so the engine is not copyable.
+        ParallelTempering(const ParallelTempering &) = delete;
+        ParallelTempering &operator=(const ParallelTempering &) = delete;
+
+        /* Ladder `minBeta^(l / (count - 1))` for `l = 0, ..., count - 1`. */
+        static std::vector<double> makeGeometricLadder(size_t count, double minBeta)
+        {
+            if (count == 0)
+                throw std::invalid_argument("ParallelTempering: `count` must be positive.");
+            if (minBeta <= 0 or minBeta > 1)
+                throw std::invalid_argument("ParallelTempering: `minBeta` must be in (0, 1].");
+            std::vector<double> betas = {1};
+            for (size_t l = 1; l < count; l++)
+                betas.push_back(std::pow(minBeta, (double)l / (count - 1)));
+            return betas;
+        }
+
+        const size_t getReplicaCount() const { return m_replicas.size(); }
+        const size_t getThreadCount() const { return m_threadCount; }
+        void setThreadCount(size_t threadCount) { m_threadCount = resolveThreadCount(threadCount); }
+        const double getBetaPrior() const { return m_betaPrior; }
+        const size_t getRound() const { return m_round; }
+
+        const std::vector<double> &getBetas() const { return m_betas; }
+        const std::vector<size_t> &getReplicaAtLevel() const { return m_replicaAtLevel; }
+        Model &getReplica(size_t replicaIndex) { return *m_replicas.at(replicaIndex); }
+        const Model &getReplica(size_t replicaIndex) const { return *m_replicas.at(replicaIndex); }
+        Model &getColdReplica() { return *m_replicas[m_replicaAtLevel[0]]; }
+        const Model &getColdReplica() const { return *m_replicas[m_replicaAtLevel[0]]; }
+
+        /* Adapts the ladder after each of the next `numRounds` rounds, with a
+         * step size decaying as `rate * lag / (round + lag)`. */
+        void setAdaptation(size_t numRounds, double rate = 1, double lag = 100)
+        {
+            if (rate < 0 or lag <= 0)
+                throw std::invalid_argument("ParallelTempering: adaptation `rate` must be non-negative and `lag` positive.");
+            m_adaptationRounds = m_round + numRounds;
+            m_adaptationRate = rate;
+            m_adaptationLag = lag;
+        }
+        const bool isAdapting() const { return m_round < m_adaptationRounds; }
+
+        /* The sink receives the level-0 replica after every round, before swaps. */
+        void setSink(const SampleSink &sink) { m_sink = sink; }
+
+        /* Runs `numRounds` rounds of `numStepsPerRound` steps per level, and
+         * returns the summary of the moves made at level 0. */
+        const MCMCSummary run(size_t numRounds, size_t numStepsPerRound)
+        {
+            const size_t levelCount = m_replicas.size();
+            MCMCSummary coldSummary;
+            std::vector<MCMCSummary> summaries(levelCount);
+            for (size_t round = 0; round < numRounds; round++)
+            {
+                parallelFor(levelCount, m_threadCount, [&](size_t l)
+                            {
+                                Model &replica = *m_replicas[m_replicaAtLevel[l]];
+                                summaries[l] = replica.metropolisGraphSweep(numStepsPerRound, m_betaPrior, m_betas[l]);
+                                m_logLikelihoods[m_replicaAtLevel[l]] = replica.getLogLikelihood(); });
+                coldSummary.join(summaries[0]);
+                if (m_sink)
+                    m_sink(m_round, getColdReplica(), summaries[0]);
+
+                for (size_t parity = 0; parity < 2; parity++)
+                    for (size_t l = parity; l + 1 < levelCount; l += 2)
+                        attemptSwap(l);
+                if (isAdapting() and levelCount > 2)
+                    adaptLadder();
+                m_round++;
+            }
+            return coldSummary;
+        }
+
+        const std::vector<double> &getLogLikelihoods() const { return m_logLikelihoods; }
+        const std::vector<SwapStatistics> &getSwapStatistics() const { return m_swapStatistics; }
+        std::vector<double> getSwapAcceptanceRates() const
+        {
+            std::vector<double> rates;
+            for (const auto &s : m_swapStatistics)
+                rates.push_back(s.getAcceptanceRate());
+            return rates;
+        }
+        void resetSwapStatistics()
+        {
+            for (auto &s : m_swapStatistics)
+                s = SwapStatistics();
+        }
+    };
+
+}
+
+#endif
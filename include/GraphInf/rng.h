@@ -3,6 +3,7 @@
 
 
 #include <random>
+#include <vector>
 #include "GraphInf/types.h"
 
 
@@ -15,6 +16,12 @@ void seed(size_t n);
 void seedWithTime();
 const size_t& getSeed();
 
+/* Independent streams for running several chains side by side. Stream `k` is
+ * the generator seeded with `masterSeed` and jumped ahead k * 2^128 draws, so
+ * that streams derived from the same master seed never overlap. */
+RNG makeRNGStream(size_t masterSeed, size_t streamIndex);
+std::vector<RNG> makeRNGStreams(size_t masterSeed, size_t streamCount);
+
 } // namespace GraphInf
 
 #endif
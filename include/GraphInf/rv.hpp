@@ -1,22 +1,117 @@
 #ifndef GRAPH_INF_RV_HPP
 #define GRAPH_INF_RV_HPP
 
-#include <functional>
+#include <vector>
+
+#include "GraphInf/rng.h"
 
 namespace GraphInf
 {
 
+    /* Set of the variables processed by the computation running on the calling
+     * thread. A computation visits a handful of variables, so they are scanned
+     * in a plain per-thread array, which only moves to the heap past
+     * `INLINE_CAPACITY` variables. */
+    class ProcessedVariables
+    {
+        enum
+        {
+            INLINE_CAPACITY = 32
+        };
+        // Trivial, so that accessing it costs no thread-local initialization check.
+        struct Storage
+        {
+            const void *inlined[INLINE_CAPACITY];
+            const void **items;
+            size_t size, capacity;
+        };
+        static Storage &getStorage()
+        {
+            static thread_local Storage storage;
+            return storage;
+        }
+        static void grow(Storage &storage)
+        {
+            static thread_local std::vector<const void *> heap;
+            if (storage.items != heap.data())
+                heap.assign(storage.items, storage.items + storage.size);
+            heap.resize(2 * storage.capacity);
+            storage.items = heap.data();
+            storage.capacity = heap.size();
+        }
+        // Recently processed variables are the likeliest to be looked up.
+        static const void **find(const Storage &storage, const void *variable)
+        {
+            for (size_t i = storage.size; i-- > 0;)
+                if (storage.items[i] == variable)
+                    return storage.items + i;
+            return nullptr;
+        }
+
+        static void append(Storage &storage, const void *variable)
+        {
+            if (storage.size == storage.capacity)
+                reserve(storage);
+            storage.items[storage.size++] = variable;
+        }
+        static void reserve(Storage &storage)
+        {
+            if (storage.items == nullptr)
+            {
+                storage.items = storage.inlined;
+                storage.capacity = INLINE_CAPACITY;
+            }
+            else
+                grow(storage);
+        }
+
+    public:
+        static bool contains(const void *variable) { return find(getStorage(), variable) != nullptr; }
+        static void insert(const void *variable)
+        {
+            Storage &storage = getStorage();
+            if (not find(storage, variable))
+                append(storage, variable);
+        }
+        // As insert, without the search, for a variable known to be absent.
+        static void append(const void *variable) { append(getStorage(), variable); }
+        /* Number of variables processed on the calling thread. A computation
+         * only adds variables, so truncating back to the size it started with
+         * drops all of its variables at once. */
+        static size_t size() { return getStorage().size; }
+        static void truncate(size_t size)
+        {
+            Storage &storage = getStorage();
+            if (size < storage.size)
+                storage.size = size;
+        }
+        static void erase(const void *variable)
+        {
+            Storage &storage = getStorage();
+            if (const void **item = find(storage, variable))
+                *item = storage.items[--storage.size];
+        }
+    };
+
     class NestedRandomVariable
     {
     public:
+        // A computation interrupted by an exception leaves its variables flagged.
+        virtual ~NestedRandomVariable() { setProcessed(false); }
         bool isRoot() const { return m_isRoot; }
         virtual bool isRoot(bool condition) const { return m_isRoot = condition; }
-        bool isProcessed() const { return m_isProcessed; }
-        virtual bool isProcessed(bool condition) const { return m_isProcessed = condition; }
+        bool isProcessed() const { return ProcessedVariables::contains(this); }
+        virtual bool isProcessed(bool condition) const
+        {
+            setProcessed(condition);
+            return condition;
+        }
         virtual void checkSelfConsistency() const {};
         virtual void checkSelfSafety() const {};
-        virtual void computationFinished() const { m_isProcessed = false; }
+        virtual void computationFinished() const { setProcessed(false); }
         virtual bool isSafe() const { return true; }
+        virtual void setRNG(RNG &gen) { m_rngPtr = &gen; }
+        RNG &getRNG() const { return *m_rngPtr; }
 
         void checkConsistency() const
         {
@@ -30,56 +125,72 @@ namespace GraphInf
         }
 
     protected:
-        template <typename RETURN_TYPE>
-        RETURN_TYPE processRecursiveConstFunction(const std::function<RETURN_TYPE()> &func, RETURN_TYPE init) const
+        /* Recursion guards: `func` runs at most once per computation across the
+         * tree of variables, and the root resets the processed flags once done.
+         * `func` is any callable taken by reference, so the lambdas passed here
+         * are inlined rather than type-erased.
+         *
+         * The processed flags are kept per thread (see `ProcessedVariables`),
+         * so the const methods of a model whose state is not modified meanwhile
+         * (log-likelihood, log-prior and log-ratio queries, consistency checks)
+         * can be called from any number of threads at once. */
+        template <typename RETURN_TYPE, typename Func>
+        RETURN_TYPE processRecursiveConstFunction(const Func &func, RETURN_TYPE init) const
         {
             RETURN_TYPE ret = init;
-            if (!m_isProcessed)
+            const size_t start = ProcessedVariables::size();
+            const bool processed = isProcessed();
+            if (!processed)
                 ret = func();
-
             if (m_isRoot)
-                computationFinished();
-            else
-                m_isProcessed = true;
+                finishRootFunction(start);
+            else if (!processed)
+                ProcessedVariables::append(this);
             return ret;
         }
-        void processRecursiveConstFunction(const std::function<void()> &func) const
+        template <typename Func>
+        void processRecursiveConstFunction(const Func &func) const
         {
-            if (!m_isProcessed)
+            const size_t start = ProcessedVariables::size();
+            const bool processed = isProcessed();
+            if (!processed)
                 func();
-            m_isProcessed = true;
             if (m_isRoot)
-                computationFinished();
-            else
-                m_isProcessed = true;
+                finishRootFunction(start);
+            else if (!processed)
+                ProcessedVariables::append(this);
         }
-
-        template <typename RETURN_TYPE>
-        RETURN_TYPE processRecursiveFunction(const std::function<RETURN_TYPE()> &func, RETURN_TYPE init) const
+        /* The root drops every variable processed since `start` in one step,
+         * so that the erasures of computationFinished find nothing left to
+         * search. The other variables flag themselves once done, by appending
+         * since they were just found absent. */
+        void finishRootFunction(size_t start) const
         {
-            RETURN_TYPE ret = init;
-            if (!m_isProcessed)
-                ret = func();
+            ProcessedVariables::truncate(start);
+            computationFinished();
+        }
 
-            if (m_isRoot)
-                computationFinished();
-            else
-                m_isProcessed = true;
-            return ret;
+        template <typename RETURN_TYPE, typename Func>
+        RETURN_TYPE processRecursiveFunction(const Func &func, RETURN_TYPE init) const
+        {
+            return processRecursiveConstFunction<RETURN_TYPE>(func, init);
         }
-        void processRecursiveFunction(const std::function<void()> &func)
+        template <typename Func>
+        void processRecursiveFunction(const Func &func)
         {
-            if (!m_isProcessed)
-                func();
-            m_isProcessed = true;
-            if (m_isRoot)
-                computationFinished();
+            processRecursiveConstFunction(func);
+        }
+
+        void setProcessed(bool condition) const
+        {
+            if (condition)
+                ProcessedVariables::insert(this);
             else
-                m_isProcessed = true;
+                ProcessedVariables::erase(this);
         }
 
         mutable bool m_isRoot = true;
-        mutable bool m_isProcessed = false;
+        RNG *m_rngPtr = &rng;
     };
 
 }
@@ -8,6 +8,7 @@
 #include "BaseGraph/undirected_multigraph.hpp"
 #include "BaseGraph/types.h"
 #include "GraphInf/utility/maps.hpp"
+#include "GraphInf/utility/xoshiro256.h"
 
 namespace GraphInf
 {
@@ -15,7 +16,7 @@ namespace GraphInf
     template <typename T>
     using Matrix = std::vector<std::vector<T>>;
 
-    typedef std::mt19937_64 RNG;
+    typedef Xoshiro256StarStar RNG;
 
     typedef BaseGraph::UndirectedMultigraph MultiGraph;
     typedef BaseGraph::UndirectedMultigraph LabelGraph;
@@ -0,0 +1,228 @@
+#ifndef GRAPH_INF_PARALLEL_HPP
+#define GRAPH_INF_PARALLEL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace GraphInf
+{
+
+    // Resolves a requested thread count, where 0 means one per hardware thread.
+    inline size_t resolveThreadCount(size_t threadCount)
+    {
+        if (threadCount == 0)
+            threadCount = std::max<size_t>(1, std::thread::hardware_concurrency());
+        return threadCount;
+    }
+
+    /* Calls `task(i)` for every `i` in [0, count) on at most `threadCount`
+     * threads, the calling thread included. Indices are handed out dynamically,
+     * so `task` must not depend on the order in which they run. The first
+     * exception thrown by a task (in index order) is rethrown once all the
+     * threads are joined. */
+    template <typename Task>
+    void parallelFor(size_t count, size_t threadCount, const Task &task)
+    {
+        std::atomic<size_t> next(0);
+        std::vector<std::exception_ptr> errors(count);
+        auto worker = [&]()
+        {
+            for (size_t i = next++; i < count; i = next++)
+            {
+                try
+                {
+                    task(i);
+                }
+                catch (...)
+                {
+                    errors[i] = std::current_exception();
+                }
+            }
+        };
+
+        std::vector<std::thread> workers;
+        for (size_t t = 1; t < std::min(resolveThreadCount(threadCount), count); t++)
+            workers.push_back(std::thread(worker));
+        worker();
+        for (auto &w : workers)
+            w.join();
+
+        for (auto &error : errors)
+            if (error)
+                std::rethrow_exception(error);
+    }
+
+    /* Fixed set of worker threads for loops that are too short to pay for
+     * spawning threads every time (e.g. one batch of MCMC proposals). The
+     * calling thread takes part in every loop, so a pool of `threadCount`
+     * threads holds `threadCount - 1` workers. Loops submitted from several
+     * threads run one after the other. */
+    class ThreadPool
+    {
+        std::vector<std::thread> m_workers;
+        std::mutex m_submitMutex, m_mutex;
+        std::condition_variable m_taskReady, m_taskDone;
+        std::function<void(size_t)> m_task;
+        std::vector<std::exception_ptr> m_errors;
+        std::atomic<size_t> m_next;
+        size_t m_count = 0, m_activeWorkers = 0, m_generation = 0;
+        bool m_stop = false;
+
+        void runTask()
+        {
+            for (size_t i = m_next++; i < m_count; i = m_next++)
+            {
+                try
+                {
+                    m_task(i);
+                }
+                catch (...)
+                {
+                    m_errors[i] = std::current_exception();
+                }
+            }
+        }
+        void work()
+        {
+            size_t generation = 0;
+            while (true)
+            {
+                {
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    m_taskReady.wait(lock, [&]()
+                                     { return m_stop or m_generation != generation; });
+                    if (m_stop)
+                        return;
+                    generation = m_generation;
+                }
+                runTask();
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (--m_activeWorkers == 0)
+                    m_taskDone.notify_one();
+            }
+        }
+
+    public:
+        explicit ThreadPool(size_t threadCount = 0) : m_next(0)
+        {
+            for (size_t t = 1; t < resolveThreadCount(threadCount); t++)
+                m_workers.push_back(std::thread(&ThreadPool::work, this));
+        }
+        ~ThreadPool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stop = true;
+            }
+            m_taskReady.notify_all();
+            for (auto &w : m_workers)
+                w.join();
+        }
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        size_t getThreadCount() const { return m_workers.size() + 1; }
+
+        /* Same contract as the free function `parallelFor`. */
+        void parallelFor(size_t count, const std::function<void(size_t)> &task)
+        {
+            if (m_workers.size() == 0 or count < 2)
+            {
+                for (size_t i = 0; i < count; i++)
+                    task(i);
+                return;
+            }
+
+            std::lock_guard<std::mutex> submitLock(m_submitMutex);
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_task = task;
+                m_count = count;
+                m_next = 0;
+                m_errors.assign(count, nullptr);
+                m_activeWorkers = m_workers.size();
+                m_generation++;
+            }
+            m_taskReady.notify_all();
+            runTask();
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_taskDone.wait(lock, [&]()
+                                { return m_activeWorkers == 0; });
+                m_task = nullptr;
+            }
+            for (auto &error : m_errors)
+                if (error)
+                    std::rethrow_exception(error);
+        }
+    };
+
+    /* Calls `task(begin, end)` for each block of `blockSize` consecutive
+     * indices covering [0, count), the blocks running concurrently on `pool`. */
+    template <typename Task>
+    void parallelForBlocks(ThreadPool &pool, size_t count, size_t blockSize, const Task &task)
+    {
+        const size_t numBlocks = (count + blockSize - 1) / blockSize;
+        pool.parallelFor(numBlocks, [&](size_t block)
+                         { task(block * blockSize, std::min(count, (block + 1) * blockSize)); });
+    }
+
+    /* Sum of `term(i)` over [0, count), accumulated in order within each block
+     * of `blockSize` indices, then across the blocks in order. The rounding
+     * only depends on `blockSize`, so the sum is the same bit for bit
+     * whatever the thread count of `pool`. */
+    template <typename Term>
+    double parallelSum(ThreadPool &pool, size_t count, size_t blockSize, const Term &term)
+    {
+        std::vector<double> blockSums((count + blockSize - 1) / blockSize, 0);
+        parallelForBlocks(pool, count, blockSize, [&](size_t begin, size_t end)
+                          {
+                              double sum = 0;
+                              for (size_t i = begin; i < end; i++)
+                                  sum += term(i);
+                              blockSums[begin / blockSize] = sum; });
+        double sum = 0;
+        for (auto blockSum : blockSums)
+            sum += blockSum;
+        return sum;
+    }
+
+    /* Thread count of a model, whose pool is only built when first used so
+     * that models never evaluated concurrently spawn no thread. Copies share
+     * the pool. */
+    class LazyThreadPool
+    {
+        size_t m_threadCount = 1;
+        mutable std::shared_ptr<ThreadPool> m_poolPtr = nullptr;
+
+    public:
+        void setThreadCount(size_t threadCount)
+        {
+            m_threadCount = resolveThreadCount(threadCount);
+            m_poolPtr = nullptr;
+        }
+        const size_t getThreadCount() const { return m_threadCount; }
+        // Safe to call from several threads at once; only one pool is kept.
+        ThreadPool &get() const
+        {
+            auto poolPtr = std::atomic_load(&m_poolPtr);
+            if (poolPtr == nullptr)
+            {
+                auto newPoolPtr = std::make_shared<ThreadPool>(m_threadCount);
+                if (std::atomic_compare_exchange_strong(&m_poolPtr, &poolPtr, newPoolPtr))
+                    poolPtr = newPoolPtr;
+            }
+            return *poolPtr;
+        }
+    };
+
+}
+
+#endif
@@ -0,0 +1,50 @@
+#ifndef GRAPH_INF_PHILOX_H
+#define GRAPH_INF_PHILOX_H
+
+#include <array>
+#include <cstdint>
+
+namespace GraphInf
+{
+
+    /* Philox4x32-10 counter-based generator of Salmon et al., "Parallel random
+     * numbers: as easy as 1, 2, 3" (Random123). Each draw is a bijection of a
+     * 128-bit counter under a 64-bit key, so it can be computed from its
+     * (key, counter) alone, in any order and on any thread. */
+    class Philox4x32
+    {
+    public:
+        typedef std::array<uint32_t, 4> Counter;
+        typedef std::array<uint32_t, 2> Key;
+
+        static Counter generate(Counter counter, Key key)
+        {
+            for (size_t round = 0; round < 10; round++)
+            {
+                if (round > 0)
+                {
+                    key[0] += 0x9E3779B9;
+                    key[1] += 0xBB67AE85;
+                }
+                const uint64_t product0 = (uint64_t)0xD2511F53 * counter[0];
+                const uint64_t product1 = (uint64_t)0xCD9E8D57 * counter[2];
+                counter = {{(uint32_t)(product1 >> 32) ^ counter[1] ^ key[0], (uint32_t)product1,
+                            (uint32_t)(product0 >> 32) ^ counter[3] ^ key[1], (uint32_t)product0}};
+            }
+            return counter;
+        }
+
+        // Uniform double in [0, 1) drawn at counter (first, second) under `key`.
+        static double uniform(uint64_t key, uint64_t first, uint64_t second)
+        {
+            const Counter draw = generate(
+                {{(uint32_t)first, (uint32_t)(first >> 32), (uint32_t)second, (uint32_t)(second >> 32)}},
+                {{(uint32_t)key, (uint32_t)(key >> 32)}});
+            const uint64_t bits = ((uint64_t)draw[0] << 32) | draw[1];
+            return (bits >> 11) * (1.0 / 9007199254740992.0);
+        }
+    };
+
+}
+
+#endif
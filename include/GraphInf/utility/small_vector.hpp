@@ -0,0 +1,108 @@
+#ifndef GRAPH_INF_SMALL_VECTOR_HPP
+#define GRAPH_INF_SMALL_VECTOR_HPP
+
+#include <algorithm>
+#include <initializer_list>
+#include <stdexcept>
+#include <vector>
+
+namespace GraphInf
+{
+
+    /* Sequence storing up to `N` elements inline, without heap allocation.
+     * Beyond `N`, the elements move to a heap-allocated vector until `clear`.
+     * `T` must be default constructible and copyable. */
+    template <typename T, size_t N>
+    class SmallVector
+    {
+        T m_inline[N];
+        std::vector<T> m_heap;
+        size_t m_size = 0;
+        bool m_onHeap = false;
+
+    public:
+        typedef T value_type;
+        typedef T *iterator;
+        typedef const T *const_iterator;
+        typedef size_t size_type;
+
+        SmallVector() {}
+        SmallVector(std::initializer_list<T> values) { assign(values.begin(), values.end()); }
+        SmallVector(const std::vector<T> &values) { assign(values.begin(), values.end()); }
+
+        template <typename InputIt>
+        void assign(InputIt first, InputIt last)
+        {
+            clear();
+            for (; first != last; ++first)
+                push_back(*first);
+        }
+
+        size_t size() const { return m_size; }
+        bool empty() const { return m_size == 0; }
+        static constexpr size_t inlineCapacity() { return N; }
+        bool isInline() const { return not m_onHeap; }
+
+        T *data() { return m_onHeap ? m_heap.data() : m_inline; }
+        const T *data() const { return m_onHeap ? m_heap.data() : m_inline; }
+        iterator begin() { return data(); }
+        iterator end() { return data() + m_size; }
+        const_iterator begin() const { return data(); }
+        const_iterator end() const { return data() + m_size; }
+
+        T &operator[](size_t i) { return data()[i]; }
+        const T &operator[](size_t i) const { return data()[i]; }
+        T &at(size_t i)
+        {
+            if (i >= m_size)
+                throw std::out_of_range("SmallVector: index out of range.");
+            return data()[i];
+        }
+        const T &at(size_t i) const
+        {
+            if (i >= m_size)
+                throw std::out_of_range("SmallVector: index out of range.");
+            return data()[i];
+        }
+        T &front() { return data()[0]; }
+        const T &front() const { return data()[0]; }
+        T &back() { return data()[m_size - 1]; }
+        const T &back() const { return data()[m_size - 1]; }
+
+        void push_back(const T &value)
+        {
+            if (m_onHeap)
+                m_heap.push_back(value);
+            else if (m_size < N)
+                m_inline[m_size] = value;
+            else
+            {
+                m_heap.reserve(2 * N);
+                m_heap.assign(m_inline, m_inline + N);
+                m_heap.push_back(value);
+                m_onHeap = true;
+            }
+            m_size++;
+        }
+        void pop_back()
+        {
+            if (m_onHeap)
+                m_heap.pop_back();
+            m_size--;
+        }
+        void clear()
+        {
+            m_heap.clear();
+            m_size = 0;
+            m_onHeap = false;
+        }
+
+        std::vector<T> toVector() const { return std::vector<T>(begin(), end()); }
+
+        bool operator==(const SmallVector &other) const { return m_size == other.m_size and std::equal(begin(), end(), other.begin()); }
+        bool operator!=(const SmallVector &other) const { return not(*this == other); }
+    };
+
+}
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef GRAPH_INF_SUM_TREE_HPP
+#define GRAPH_INF_SUM_TREE_HPP
+
+#include <vector>
+#include <cstddef>
+
+namespace GraphInf
+{
+
+    /* Nonnegative weights of the indices [0, size) held at the leaves of a
+     * complete binary tree whose nodes store the sum of their children, so
+     * that setting a weight and sampling an index in proportion to its weight
+     * both take O(log size). Every node is recomputed from its children
+     * rather than shifted, so that the sums do not drift. */
+    class SumTree
+    {
+        size_t m_size = 0, m_capacity = 1;
+        std::vector<double> m_nodes = std::vector<double>(2, 0);
+
+    public:
+        explicit SumTree(size_t size = 0) { resize(size); }
+
+        // Sets the number of indices, all with weight zero.
+        void resize(size_t size)
+        {
+            m_size = size;
+            m_capacity = 1;
+            while (m_capacity < size)
+                m_capacity *= 2;
+            m_nodes.assign(2 * m_capacity, 0);
+        }
+        const size_t size() const { return m_size; }
+        const double getTotal() const { return m_nodes[1]; }
+        const double get(size_t index) const { return m_nodes[m_capacity + index]; }
+        void set(size_t index, double weight)
+        {
+            size_t node = m_capacity + index;
+            m_nodes[node] = weight;
+            for (node /= 2; node > 0; node /= 2)
+                m_nodes[node] = m_nodes[2 * node] + m_nodes[2 * node + 1];
+        }
+
+        /* Index whose cumulative weight interval contains `uniform` times the
+         * total, for `uniform` in [0, 1). Indices of weight zero are never
+         * returned as long as the total is positive. */
+        const size_t sample(double uniform) const
+        {
+            double target = uniform * getTotal();
+            size_t node = 1;
+            while (node < m_capacity)
+            {
+                const double left = m_nodes[2 * node], right = m_nodes[2 * node + 1];
+                if (target < left or right == 0)
+                    node = 2 * node;
+                else
+                {
+                    target -= left;
+                    node = 2 * node + 1;
+                }
+            }
+            return node - m_capacity;
+        }
+    };
+
+}
+
+#endif
@@ -0,0 +1,114 @@
+#ifndef GRAPH_INF_XOSHIRO256_H
+#define GRAPH_INF_XOSHIRO256_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace GraphInf
+{
+
+    /* xoshiro256** generator of Blackman & Vigna (https://prng.di.unimi.it).
+     * Satisfies UniformRandomBitGenerator, so it can be used with the
+     * distributions of <random>. `jump()` advances the state by 2^128 draws,
+     * which is how independent, non-overlapping streams are derived from a
+     * single seed (see `makeRNGStream`). */
+    class Xoshiro256StarStar
+    {
+    public:
+        typedef uint64_t result_type;
+        static constexpr result_type default_seed = 5489u;
+
+        explicit Xoshiro256StarStar(result_type value = default_seed) { seed(value); }
+
+        static constexpr result_type min() { return std::numeric_limits<result_type>::min(); }
+        static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+        void seed(result_type value = default_seed)
+        {
+            // The state is filled with splitmix64 outputs, as recommended by the authors.
+            uint64_t x = value;
+            for (auto &s : m_state)
+                s = splitMix64(x);
+        }
+
+        result_type operator()()
+        {
+            const uint64_t result = rotl(m_state[1] * 5, 7) * 9;
+            const uint64_t t = m_state[1] << 17;
+            m_state[2] ^= m_state[0];
+            m_state[3] ^= m_state[1];
+            m_state[1] ^= m_state[2];
+            m_state[0] ^= m_state[3];
+            m_state[2] ^= t;
+            m_state[3] = rotl(m_state[3], 45);
+            return result;
+        }
+
+        void discard(unsigned long long n)
+        {
+            for (unsigned long long i = 0; i < n; i++)
+                (*this)();
+        }
+
+        // Equivalent to 2^128 calls to operator().
+        void jump()
+        {
+            static const uint64_t JUMP[] = {0x180ec6d33cfd0aba, 0xd5a61266f0c9392c, 0xa9582618e03fc9aa, 0x39abdc4529b1661c};
+            applyJumpPolynomial(JUMP);
+        }
+
+        // Equivalent to 2^192 calls to operator().
+        void longJump()
+        {
+            static const uint64_t LONG_JUMP[] = {0x76e15d3efefdcbbf, 0xc5004e441c522fb3, 0x77710069854ee241, 0x39109bb02acbe635};
+            applyJumpPolynomial(LONG_JUMP);
+        }
+
+        bool operator==(const Xoshiro256StarStar &other) const
+        {
+            for (size_t i = 0; i < 4; i++)
+                if (m_state[i] != other.m_state[i])
+                    return false;
+            return true;
+        }
+        bool operator!=(const Xoshiro256StarStar &other) const { return not(*this == other); }
+
+    private:
+        uint64_t m_state[4];
+
+        static uint64_t rotl(const uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+        static uint64_t splitMix64(uint64_t &x)
+        {
+            uint64_t z = (x += 0x9e3779b97f4a7c15);
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+            return z ^ (z >> 31);
+        }
+        void applyJumpPolynomial(const uint64_t *polynomial)
+        {
+            uint64_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+            for (size_t i = 0; i < 4; i++)
+            {
+                for (int b = 0; b < 64; b++)
+                {
+                    if (polynomial[i] & (uint64_t(1) << b))
+                    {
+                        s0 ^= m_state[0];
+                        s1 ^= m_state[1];
+                        s2 ^= m_state[2];
+                        s3 ^= m_state[3];
+                    }
+                    (*this)();
+                }
+            }
+            m_state[0] = s0;
+            m_state[1] = s1;
+            m_state[2] = s2;
+            m_state[3] = s3;
+        }
+    };
+
+} // namespace GraphInf
+
+#endif
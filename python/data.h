@@ -3,8 +3,11 @@
 
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
+#include <pybind11/functional.h>
 
 #include "GraphInf/types.h"
+#include "GraphInf/chain_pool.hpp"
+#include "GraphInf/parallel_tempering.hpp"
 
 #include "GraphInf/data/python/proposer.hpp"
 #include "GraphInf/data/python/data_model.hpp"
@@ -25,6 +28,22 @@ namespace py = pybind11;
 namespace GraphInf
 {
 
+    // Each model holds a reference to its python object, released with the pool.
+    inline std::function<std::shared_ptr<DataModel>(size_t)> wrapModelFactory(py::function factory)
+    {
+        return [factory](size_t index)
+        {
+            py::object model = factory(index);
+            return std::shared_ptr<DataModel>(model.cast<DataModel *>(), [model](DataModel *) {});
+        };
+    }
+
+    // Read when the pool is built, so that a later `seed` call is followed.
+    inline size_t getMasterSeed(const py::object &masterSeed)
+    {
+        return masterSeed.is_none() ? getSeed() : masterSeed.cast<size_t>();
+    }
+
     void initDataModels(py::module &m)
     {
         py::class_<ParamProposer, PyParamProposer<>>(m, "ParamProposer")
@@ -71,12 +90,19 @@ namespace GraphInf
             .def("log_acceptance_prob_from_graph_move", &DataModel::getLogAcceptanceProbFromGraphMove, py::arg("move"), py::arg("beta_prior") = 1, py::arg("beta_likelihood") = 1)
             .def("metropolis_graph_sweep", &DataModel::metropolisGraphSweep, py::arg("n_steps"), py::arg("beta_prior") = 1, py::arg("beta_likelihood") = 1, py::arg("debug_frequency") = 0)
             .def("metropolis_param_sweep", &DataModel::metropolisParamSweep, py::arg("n_steps"), py::arg("beta_prior") = 1, py::arg("beta_likelihood") = 1)
+            .def("set_speculation_width", &DataModel::setSpeculationWidth, py::arg("width"))
+            .def("speculation_width", &DataModel::getSpeculationWidth)
+            .def("set_thread_count", &DataModel::setThreadCount, py::arg("thread_count"))
+            .def("thread_count", &DataModel::getThreadCount)
             .def("greedy_graph_step", &DataModel::greedyGraphStep, py::arg("n_candidates") = 1)
             .def("greedy_param_step", &DataModel::greedyParamStep, py::arg("n_candidates") = 1)
             .def("greedy_graph_sweep", &DataModel::greedyGraphSweep, py::arg("n_steps"), py::arg("n_candidates") = 1)
             .def("greedy_param_sweep", &DataModel::greedyParamSweep, py::arg("n_steps"), py::arg("n_candidates") = 1);
 
         py::module dynamics = m.def_submodule("dynamics");
+        py::enum_<SequenceLayout>(dynamics, "SequenceLayout")
+            .value("vertex_major", SequenceLayout::VertexMajor)
+            .value("time_major", SequenceLayout::TimeMajor);
         py::class_<Dynamics, DataModel, PyDynamics<>>(dynamics, "Dynamics")
             .def(py::init<RandomGraph &, size_t, size_t>(),
                  py::arg("graph_prior"),
@@ -90,6 +116,8 @@ namespace GraphInf
                 "sample_state", [](Dynamics &self, bool asyncMode = false, size_t initialBurn = 0)
                 { self.sampleState({}, asyncMode, initialBurn); },
                 py::arg("async_mode") = false, py::arg("initial_burn") = 0)
+            .def("sample_state_from_events", &Dynamics::sampleStateFromEvents,
+                 py::arg("initial") = State(), py::arg("initial_burn") = 0.)
             .def(
                 "sample", [](Dynamics &self, const State &initial, bool asyncMode = false, size_t initialBurn = 0)
                 { self.sample(initial, asyncMode, initialBurn); },
@@ -105,16 +133,31 @@ namespace GraphInf
                  { 
                     self.setGraph(other.getGraph());
                     self.setState(other.getPastStates(), other.getFutureStates()); })
-            .def("set_state", py::overload_cast<Matrix<VertexState>>(&Dynamics::setState), py::arg("state"))
-            .def("set_state", py::overload_cast<Matrix<VertexState>, Matrix<VertexState>>(&Dynamics::setState), py::arg("past"), py::arg("future"))
+            .def("set_state", py::overload_cast<const Matrix<VertexState> &>(&Dynamics::setState), py::arg("state"))
+            .def("set_state", py::overload_cast<const Matrix<VertexState> &, const Matrix<VertexState> &>(&Dynamics::setState), py::arg("past"), py::arg("future"))
+            .def("set_state_from_file", &Dynamics::setStateFromFile, py::arg("path"), py::arg("layout") = SequenceLayout::VertexMajor)
+            .def("append_states", py::overload_cast<const Matrix<VertexState> &, size_t>(&Dynamics::appendStates), py::arg("states"), py::arg("max_length") = 0)
+            .def("append_states", py::overload_cast<const Matrix<VertexState> &, const Matrix<VertexState> &, size_t>(&Dynamics::appendStates), py::arg("past"), py::arg("future"), py::arg("max_length") = 0)
             .def("neighbors_state", &Dynamics::getNeighborsState, py::return_value_policy::reference_internal)
-            .def("past_states", &Dynamics::getPastStates, py::return_value_policy::reference_internal)
-            .def("past_neighbors_states", &Dynamics::getNeighborsPastStates, py::return_value_policy::reference_internal)
-            .def("future_states", &Dynamics::getFutureStates, py::return_value_policy::reference_internal)
+            .def("past_states", [](const Dynamics &self) -> Matrix<VertexState>
+                 { return self.getPastStates(); })
+            .def("past_neighbors_states", [](const Dynamics &self) -> Matrix<VertexNeighborhoodState>
+                 { return (self.getNeighborsPastStates().size() == 0) ? self.computeNeighborsStateSequence(self.getPastStates()) : self.getNeighborsPastStates(); })
+            .def("future_states", [](const Dynamics &self) -> Matrix<VertexState>
+                 { return self.getFutureStates(); })
             .def("neighbors_state_copy", &Dynamics::getNeighborsState, py::return_value_policy::copy)
-            .def("past_states_copy", &Dynamics::getPastStates, py::return_value_policy::copy)
-            .def("past_neighbors_states_copy", &Dynamics::getNeighborsPastStates, py::return_value_policy::copy)
-            .def("future_states_copy", &Dynamics::getFutureStates, py::return_value_policy::copy)
+            .def("past_states_copy", [](const Dynamics &self) -> Matrix<VertexState>
+                 { return self.getPastStates(); })
+            .def("past_neighbors_states_copy", [](const Dynamics &self) -> Matrix<VertexNeighborhoodState>
+                 { return (self.getNeighborsPastStates().size() == 0) ? self.computeNeighborsStateSequence(self.getPastStates()) : self.getNeighborsPastStates(); })
+            .def("future_states_copy", [](const Dynamics &self) -> Matrix<VertexState>
+                 { return self.getFutureStates(); })
+            .def("set_log_likelihood_caching", &Dynamics::setLogLikelihoodCaching, py::arg("cache"))
+            .def("log_likelihood_caching", &Dynamics::getLogLikelihoodCaching)
+            .def("set_neighbors_past_state_caching", &Dynamics::setNeighborsPastStateCaching, py::arg("cache"))
+            .def("neighbors_past_state_caching", &Dynamics::getNeighborsPastStateCaching)
+            .def("sequence_layout", &Dynamics::getSequenceLayout)
+            .def("set_sequence_layout", &Dynamics::setSequenceLayout, py::arg("layout"))
             .def("num_states", &Dynamics::getNumStates)
             .def("length", &Dynamics::getLength)
             .def("set_length", &Dynamics::setLength)
@@ -149,6 +192,11 @@ namespace GraphInf
             .def("set_auto_deactivation_prob", &BinaryDynamics::setAutoDeactivationProb, py::arg("auto_deactivation_prob"))
             .def("auto_activation_prob", &BinaryDynamics::getAutoActivationProb)
             .def("auto_deactivation_prob", &BinaryDynamics::getAutoDeactivationProb)
+            .def("state_packing", &BinaryDynamics::getStatePacking)
+            .def(
+                "set_state_packing", [](BinaryDynamics &self, bool pack)
+                { self.setStatePacking(pack); },
+                py::arg("pack"))
             .def("random_state", [](const BinaryDynamics &self)
                  { return self.getRandomState(); })
             .def(
@@ -238,6 +286,56 @@ namespace GraphInf
 
         py::class_<PoissonUncertainGraph, UncertainGraph>(uncertain, "PoissonUncertainGraph")
             .def(py::init<RandomGraph &, double, double>(), py::arg("prior"), py::arg("mu"), py::arg("mu_no_edge") = 0);
+
+        py::class_<ChainStatistics>(m, "ChainStatistics")
+            .def_readonly("sweeps", &ChainStatistics::sweeps)
+            .def_readonly("seconds", &ChainStatistics::seconds)
+            .def("sweeps_per_second", &ChainStatistics::getSweepsPerSecond);
+
+        py::class_<ChainPool<DataModel>>(m, "ChainPool")
+            .def(py::init([](py::function factory, size_t chainCount, py::object masterSeed, size_t threadCount)
+                          { return new ChainPool<DataModel>(wrapModelFactory(factory), chainCount, getMasterSeed(masterSeed), threadCount); }),
+                 py::arg("factory"), py::arg("chain_count"), py::arg("master_seed") = py::none(), py::arg("thread_count") = 0)
+            .def("chain_count", &ChainPool<DataModel>::getChainCount)
+            .def("thread_count", &ChainPool<DataModel>::getThreadCount)
+            .def("set_thread_count", &ChainPool<DataModel>::setThreadCount, py::arg("thread_count"))
+            .def("chain", py::overload_cast<size_t>(&ChainPool<DataModel>::getChain), py::arg("chain_index"), py::return_value_policy::reference_internal)
+            .def("set_sink", &ChainPool<DataModel>::setSink, py::arg("chain_index"), py::arg("sink"))
+            .def("set_sinks", &ChainPool<DataModel>::setSinks, py::arg("sink"))
+            .def("run", &ChainPool<DataModel>::run, py::arg("n_sweeps"), py::arg("n_steps_per_sweep"),
+                 py::arg("beta_prior") = 1, py::arg("beta_likelihood") = 1, py::call_guard<py::gil_scoped_release>())
+            .def("chain_summaries", &ChainPool<DataModel>::getChainSummaries)
+            .def("chain_statistics", &ChainPool<DataModel>::getChainStatistics)
+            .def("sweeps_per_second", &ChainPool<DataModel>::getSweepsPerSecond);
+
+        py::class_<SwapStatistics>(m, "SwapStatistics")
+            .def_readonly("attempted", &SwapStatistics::attempted)
+            .def_readonly("accepted", &SwapStatistics::accepted)
+            .def("acceptance_rate", &SwapStatistics::getAcceptanceRate);
+
+        typedef ParallelTempering<DataModel> PT;
+        py::class_<PT>(m, "ParallelTempering")
+            .def(py::init([](py::function factory, std::vector<double> betas, py::object masterSeed, double betaPrior, size_t threadCount)
+                          { return new PT(wrapModelFactory(factory), betas, getMasterSeed(masterSeed), betaPrior, threadCount); }),
+                 py::arg("factory"), py::arg("betas"), py::arg("master_seed") = py::none(), py::arg("beta_prior") = 1, py::arg("thread_count") = 0)
+            .def_static("geometric_ladder", &PT::makeGeometricLadder, py::arg("count"), py::arg("min_beta"))
+            .def("replica_count", &PT::getReplicaCount)
+            .def("thread_count", &PT::getThreadCount)
+            .def("set_thread_count", &PT::setThreadCount, py::arg("thread_count"))
+            .def("beta_prior", &PT::getBetaPrior)
+            .def("round", &PT::getRound)
+            .def("betas", &PT::getBetas)
+            .def("replica_at_level", &PT::getReplicaAtLevel)
+            .def("replica", py::overload_cast<size_t>(&PT::getReplica), py::arg("replica_index"), py::return_value_policy::reference_internal)
+            .def("cold_replica", py::overload_cast<>(&PT::getColdReplica), py::return_value_policy::reference_internal)
+            .def("set_adaptation", &PT::setAdaptation, py::arg("n_rounds"), py::arg("rate") = 1, py::arg("lag") = 100)
+            .def("is_adapting", &PT::isAdapting)
+            .def("set_sink", &PT::setSink, py::arg("sink"))
+            .def("run", &PT::run, py::arg("n_rounds"), py::arg("n_steps_per_round"), py::call_guard<py::gil_scoped_release>())
+            .def("log_likelihoods", &PT::getLogLikelihoods)
+            .def("swap_statistics", &PT::getSwapStatistics)
+            .def("swap_acceptance_rates", &PT::getSwapAcceptanceRates)
+            .def("reset_swap_statistics", &PT::resetSwapStatistics);
     }
 
 }
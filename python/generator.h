@@ -13,25 +13,42 @@ void initGenerators(py::module &m)
 {
 
     /* Random variable generators */
-    m.def("generateCategorical", &generateCategorical<double, int>, py::arg("weights"));
-    m.def("generateCategorical", &generateCategorical<int, int>, py::arg("weights"));
-    m.def("sampleSequenceWithoutReplacement", &sampleUniformlySequenceWithoutReplacement, py::arg("n"), py::arg("k"));
-    m.def("sampleRandomComposition", &sampleRandomComposition, py::arg("n"), py::arg("k"));
-    m.def("sampleRandomWeakComposition", &sampleRandomWeakComposition, py::arg("n"), py::arg("k"));
-    m.def("sampleRandomRestrictedPartition", &sampleRandomRestrictedPartition, py::arg("n"), py::arg("k"), py::arg("numSteps") = 0);
-    m.def("sampleRandomPermutation", &sampleRandomPermutation, py::arg("nk"));
-    m.def("sampleMultinomial", &sampleMultinomial, py::arg("n"), py::arg("p"));
-    m.def("sampleRandomNeighbor", &sampleRandomNeighbor, py::arg("graph"), py::arg("vertex"), py::arg("with_multiplicity") = true);
+    m.def("generateCategorical", [](const std::vector<double> &weights)
+          { return generateCategorical<double, int>(weights); }, py::arg("weights"));
+    m.def("generateCategorical", [](const std::vector<int> &weights)
+          { return generateCategorical<int, int>(weights); }, py::arg("weights"));
+    m.def("sampleSequenceWithoutReplacement", [](size_t n, size_t k)
+          { return sampleUniformlySequenceWithoutReplacement(n, k); }, py::arg("n"), py::arg("k"));
+    m.def("sampleRandomComposition", [](size_t n, size_t k)
+          { return sampleRandomComposition(n, k); }, py::arg("n"), py::arg("k"));
+    m.def("sampleRandomWeakComposition", [](size_t n, size_t k)
+          { return sampleRandomWeakComposition(n, k); }, py::arg("n"), py::arg("k"));
+    m.def("sampleRandomRestrictedPartition", [](size_t n, size_t k, size_t numSteps)
+          { return sampleRandomRestrictedPartition(n, k, numSteps); }, py::arg("n"), py::arg("k"), py::arg("numSteps") = 0);
+    m.def("sampleRandomPermutation", [](const std::vector<size_t> &nk)
+          { return sampleRandomPermutation(nk); }, py::arg("nk"));
+    m.def("sampleMultinomial", [](size_t n, const std::vector<double> &p)
+          { return sampleMultinomial(n, p); }, py::arg("n"), py::arg("p"));
+    m.def("sampleRandomNeighbor", [](const MultiGraph &graph, BaseGraph::VertexIndex vertex, bool withMultiplicity)
+          { return sampleRandomNeighbor(graph, vertex, withMultiplicity); }, py::arg("graph"), py::arg("vertex"), py::arg("with_multiplicity") = true);
 
     /* Random graph generators */
-    m.def("generateErdosRenyi", &generateErdosRenyi, py::arg("size"), py::arg("edge_count"), py::arg("with_self_loops") = true);
-    m.def("generateMultiGraphErdosRenyi", &generateMultiGraphErdosRenyi, py::arg("size"), py::arg("edge_count"), py::arg("with_self_loops") = true);
-    m.def("generateStubLabeledErdosRenyi", &generateStubLabeledErdosRenyi, py::arg("size"), py::arg("edge_count"), py::arg("with_self_loops") = true);
-    m.def("generateCM", &generateCM, py::arg("degrees"));
-    m.def("generateDCSBM", &generateDCSBM, py::arg("blocks"), py::arg("labelGraph"), py::arg("degrees"));
-    m.def("generateSBM", &generateSBM, py::arg("blocks"), py::arg("labelGraph"), py::arg("with_self_loops") = true);
-    m.def("generateMultiGraphSBM", &generateMultiGraphSBM, py::arg("blocks"), py::arg("labelGraph"), py::arg("with_self_loops") = true);
-    m.def("generateStubLabeledSBM", &generateStubLabeledSBM, py::arg("blocks"), py::arg("labelGraph"), py::arg("with_self_loops") = true);
+    m.def("generateErdosRenyi", [](size_t size, size_t edgeCount, bool withSelfLoops)
+          { return generateErdosRenyi(size, edgeCount, withSelfLoops); }, py::arg("size"), py::arg("edge_count"), py::arg("with_self_loops") = true);
+    m.def("generateMultiGraphErdosRenyi", [](size_t size, size_t edgeCount, bool withSelfLoops)
+          { return generateMultiGraphErdosRenyi(size, edgeCount, withSelfLoops); }, py::arg("size"), py::arg("edge_count"), py::arg("with_self_loops") = true);
+    m.def("generateStubLabeledErdosRenyi", [](size_t size, size_t edgeCount, bool withSelfLoops)
+          { return generateStubLabeledErdosRenyi(size, edgeCount, withSelfLoops); }, py::arg("size"), py::arg("edge_count"), py::arg("with_self_loops") = true);
+    m.def("generateCM", [](const DegreeSequence &degrees)
+          { return generateCM(degrees); }, py::arg("degrees"));
+    m.def("generateDCSBM", [](const BlockSequence &blocks, const MultiGraph &labelGraph, const DegreeSequence &degrees)
+          { return generateDCSBM(blocks, labelGraph, degrees); }, py::arg("blocks"), py::arg("labelGraph"), py::arg("degrees"));
+    m.def("generateSBM", [](const BlockSequence &blocks, const MultiGraph &labelGraph, bool withSelfLoops)
+          { return generateSBM(blocks, labelGraph, withSelfLoops); }, py::arg("blocks"), py::arg("labelGraph"), py::arg("with_self_loops") = true);
+    m.def("generateMultiGraphSBM", [](const BlockSequence &blocks, const MultiGraph &labelGraph, bool withSelfLoops)
+          { return generateMultiGraphSBM(blocks, labelGraph, withSelfLoops); }, py::arg("blocks"), py::arg("labelGraph"), py::arg("with_self_loops") = true);
+    m.def("generateStubLabeledSBM", [](const BlockSequence &blocks, const MultiGraph &labelGraph, bool withSelfLoops)
+          { return generateStubLabeledSBM(blocks, labelGraph, withSelfLoops); }, py::arg("blocks"), py::arg("labelGraph"), py::arg("with_self_loops") = true);
 }
 
 #endif
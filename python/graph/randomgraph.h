@@ -126,7 +126,9 @@ namespace GraphInf
               .def("greedy_param_sweep", &RandomGraph::greedyParamSweep, py::arg("n_steps"), py::arg("n_candidates") = 1)
               .def("greedy_param_step", &RandomGraph::greedyParamStep, py::arg("n_candidates") = 1)
               .def("greedy_graph_sweep", &RandomGraph::greedyGraphSweep, py::arg("n_steps"), py::arg("n_candidates") = 1)
-              .def("greedy_graph_step", &RandomGraph::greedyGraphStep, py::arg("n_candidates") = 1);
+              .def("greedy_graph_step", &RandomGraph::greedyGraphStep, py::arg("n_candidates") = 1)
+              .def("set_thread_count", &RandomGraph::setThreadCount, py::arg("thread_count"))
+              .def("thread_count", &RandomGraph::getThreadCount);
 
           py::class_<DeltaGraph, RandomGraph>(m, "DeltaGraph")
               .def(py::init<const MultiGraph>(), py::arg("graph"));
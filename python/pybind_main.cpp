@@ -31,7 +31,9 @@ PYBIND11_MODULE(_graphinf, m)
              { return self.isProcessed(); })
         .def("check_consistency", &NestedRandomVariable::checkConsistency)
         .def("check_safety", &NestedRandomVariable::checkSafety)
-        .def("is_safe", &NestedRandomVariable::isSafe);
+        .def("is_safe", &NestedRandomVariable::isSafe)
+        .def("set_rng", &NestedRandomVariable::setRNG, py::arg("rng"), py::keep_alive<1, 2>())
+        .def("get_rng", &NestedRandomVariable::getRNG, py::return_value_policy::reference_internal);
 
     py::module graph = m.def_submodule("graph");
     initRandomGraph(graph);
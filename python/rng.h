@@ -12,6 +12,18 @@ void initRNG(py::module &m)
 {
     m.def("seed", &seed, py::arg("n"));
     m.def("seedWithTime", &seedWithTime);
+
+    py::class_<RNG>(m, "RNG")
+        .def(py::init<RNG::result_type>(), py::arg("seed") = RNG::result_type(RNG::default_seed))
+        .def("seed", &RNG::seed, py::arg("n"))
+        .def("jump", &RNG::jump)
+        .def("long_jump", &RNG::longJump)
+        .def("__call__", [](RNG &self)
+             { return self(); });
+    m.def("get_global_rng", []() -> RNG &
+          { return rng; }, py::return_value_policy::reference);
+    m.def("make_rng_stream", &makeRNGStream, py::arg("master_seed"), py::arg("stream_index"));
+    m.def("make_rng_streams", &makeRNGStreams, py::arg("master_seed"), py::arg("stream_count"));
 }
 
 #endif
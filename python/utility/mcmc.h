@@ -27,11 +27,24 @@ namespace GraphInf
 
     void initMoveTypes(py::module &m)
     {
+        py::enum_<MoveKind>(m, "MoveKind")
+            .value("none", MoveKind::None)
+            .value("removed", MoveKind::Removed)
+            .value("added", MoveKind::Added)
+            .value("hinge_flip", MoveKind::HingeFlip)
+            .value("double_edge_flip", MoveKind::DoubleEdgeFlip)
+            .value("multiflip", MoveKind::MultiFlip)
+            .value("label_swap", MoveKind::LabelSwap)
+            .value("param", MoveKind::Param);
+
         py::class_<GraphMove>(m, "GraphMove")
             .def(py::init<std::vector<BaseGraph::Edge>, std::vector<BaseGraph::Edge>>(),
                  py::arg("removed_edges"), py::arg("added_edges"))
-            .def_readonly("removed_edges", &GraphMove::removedEdges)
-            .def_readonly("added_edges", &GraphMove::addedEdges)
+            .def_property_readonly("removed_edges", [](const GraphMove &self)
+                                   { return self.removedEdges.toVector(); })
+            .def("kind", &GraphMove::kind)
+            .def_property_readonly("added_edges", [](const GraphMove &self)
+                                   { return self.addedEdges.toVector(); })
             .def("__repr__", [](const GraphMove &self)
                  { return self.display(); });
 
@@ -75,8 +88,12 @@ namespace GraphInf
             .def("update", &MCMCSummary::update<BlockMove>, py::arg("step_summary"))
             .def("join", &MCMCSummary::join, py::arg("other"))
             .def_readonly("log_joint_ratio", &MCMCSummary::logJointRatio)
-            .def_readonly("accepted", &MCMCSummary::accepted)
-            .def_readonly("total", &MCMCSummary::total)
+            .def_property_readonly("accepted", &MCMCSummary::getAccepted)
+            .def_property_readonly("total", &MCMCSummary::getTotal)
+            .def("total_count", py::overload_cast<MoveKind>(&MCMCSummary::getTotalCount, py::const_), py::arg("kind"))
+            .def("total_count", py::overload_cast<>(&MCMCSummary::getTotalCount, py::const_))
+            .def("accepted_count", py::overload_cast<MoveKind>(&MCMCSummary::getAcceptedCount, py::const_), py::arg("kind"))
+            .def("accepted_count", py::overload_cast<>(&MCMCSummary::getAcceptedCount, py::const_))
             .def("__repr__", [](const MCMCSummary &self)
                  { return self.display(); });
     }
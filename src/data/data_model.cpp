@@ -21,23 +21,8 @@ namespace GraphInf
         return logProposalRatio + logJointRatio;
     }
 
-    const StepResult<GraphMove> DataModel::metropolisGraphStep(const double betaPrior, const double betaLikelihood, bool debug)
+    const StepResult<GraphMove> DataModel::metropolisGraphStepFromLikelihoodRatio(const GraphMove &move, double logLikelihoodRatio, double betaPrior)
     {
-        const auto move = m_graphPriorPtr->proposeGraphMove();
-        if (m_graphPriorPtr->isTrivialGraphMove(move))
-            return {};
-        auto logLikelihoodBefore = 0.0, logPriorBefore = 0.0;
-        if (debug)
-        {
-            logLikelihoodBefore = getLogLikelihood();
-            logPriorBefore = getLogPrior();
-        }
-
-        // Log likelihood ratio
-        double logLikelihoodRatio = 0;
-        if (betaLikelihood > 0)
-            logLikelihoodRatio = betaLikelihood * getLogLikelihoodRatioFromGraphMove(move);
-
         // Log prior ratio
         double logPriorRatio = 0;
         if (betaPrior > 0)
@@ -51,34 +36,59 @@ namespace GraphInf
 
         // Metropolis-Hastings step
         bool accepted = false;
-        if (m_uniform(rng) < acceptProb)
+        if (m_uniform(*m_rngPtr) < acceptProb)
         {
             accepted = true;
             applyGraphMove(move);
         }
+        return {move, logLikelihoodRatio + logPriorRatio, accepted};
+    }
+
+    const StepResult<GraphMove> DataModel::metropolisGraphStep(const double betaPrior, const double betaLikelihood, bool debug)
+    {
+        const auto move = m_graphPriorPtr->proposeGraphMove();
+        if (m_graphPriorPtr->isTrivialGraphMove(move))
+            return {};
+        auto logLikelihoodBefore = 0.0, logPriorBefore = 0.0;
+        if (debug)
+        {
+            logLikelihoodBefore = getLogLikelihood();
+            logPriorBefore = getLogPrior();
+        }
+
+        // Log likelihood ratio
+        double logLikelihoodRatio = 0;
+        if (betaLikelihood > 0)
+            logLikelihoodRatio = betaLikelihood * getLogLikelihoodRatioFromGraphMove(move);
+
+        const auto step = metropolisGraphStepFromLikelihoodRatio(move, logLikelihoodRatio, betaPrior);
         if (debug)
         {
+            double logPriorRatio = step.logJointRatio - logLikelihoodRatio;
             checkConsistency();
             auto logLikelihoodAfter = getLogLikelihood();
             auto logPriorAfter = getLogPrior();
-            if (abs(logLikelihoodAfter - logLikelihoodBefore - logLikelihoodRatio) > 1e-6 && accepted == 1)
+            if (abs(logLikelihoodAfter - logLikelihoodBefore - logLikelihoodRatio) > 1e-6 && step.accepted == 1)
             {
                 std::stringstream ss;
                 ss << "DataModel: log likelihood mismatch with move " << move.display() << ": expected_ratio=" << logLikelihoodAfter - logLikelihoodBefore << ", actual_ratio=" << logLikelihoodRatio;
                 throw std::runtime_error(ss.str());
             }
-            if (abs(logPriorAfter - logPriorBefore - logPriorRatio) > 1e-6 && accepted == 1)
+            if (abs(logPriorAfter - logPriorBefore - logPriorRatio) > 1e-6 && step.accepted == 1)
             {
                 std::stringstream ss;
                 ss << "DataModel: log prior mismatch with move " << move.display() << ": expected_ratio=" << logPriorAfter - logPriorBefore << ", actual_ratio=" << logPriorRatio;
                 throw std::runtime_error(ss.str());
             }
         }
-        return {move, logLikelihoodRatio + logPriorRatio, accepted};
+        return step;
     }
 
     const MCMCSummary DataModel::metropolisGraphSweep(size_t numSteps, const double betaPrior, const double betaLikelihood, int debugFrequency)
     {
+        if (m_speculationWidth > 1 and debugFrequency <= 0)
+            return speculativeGraphSweep(numSteps, betaPrior, betaLikelihood);
+
         MCMCSummary summary = {};
         for (size_t i = 0; i < numSteps; i++)
         {
@@ -87,6 +97,51 @@ namespace GraphInf
         }
         return summary;
     }
+
+    const MCMCSummary DataModel::speculativeGraphSweep(size_t numSteps, double betaPrior, double betaLikelihood)
+    {
+        MCMCSummary summary = {};
+        std::vector<GraphMove> moves;
+        std::vector<bool> isTrivial;
+        std::vector<double> logLikelihoodRatios;
+        ThreadPool &threadPool = m_threadPool.get();
+
+        size_t step = 0;
+        while (step < numSteps)
+        {
+            // All the proposals of a batch are drawn from the current state.
+            const size_t width = std::min(m_speculationWidth, numSteps - step);
+            moves.resize(width);
+            isTrivial.resize(width);
+            for (size_t k = 0; k < width; k++)
+            {
+                moves[k] = m_graphPriorPtr->proposeGraphMove();
+                isTrivial[k] = m_graphPriorPtr->isTrivialGraphMove(moves[k]);
+            }
+            logLikelihoodRatios.assign(width, 0);
+            if (betaLikelihood > 0)
+                threadPool.parallelFor(width, [&](size_t k)
+                                       {
+                                           if (not isTrivial[k])
+                                               logLikelihoodRatios[k] = betaLikelihood * getLogLikelihoodRatioFromGraphMove(moves[k]); });
+
+            // Once any move is accepted, the state changed and the rest of the batch is stale.
+            for (size_t k = 0; k < width; k++)
+            {
+                step++;
+                StepResult<GraphMove> graphStep = {};
+                if (not isTrivial[k])
+                    graphStep = metropolisGraphStepFromLikelihoodRatio(moves[k], logLikelihoodRatios[k], betaPrior);
+                const auto priorStep = m_graphPriorPtr->metropolisParamStep(betaPrior, betaLikelihood);
+                summary.update(graphStep);
+                summary.update(priorStep);
+                if (graphStep.accepted or priorStep.accepted)
+                    break;
+            }
+        }
+        return summary;
+    }
+
     const MCMCSummary DataModel::metropolisParamSweep(size_t numSteps, double betaPrior, double betaLikelihood)
     {
         MCMCSummary summary = {};
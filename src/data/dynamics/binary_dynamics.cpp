@@ -1,3 +1,7 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 #include "GraphInf/data/dynamics/binary_dynamics.h"
 
 namespace GraphInf
@@ -10,12 +14,71 @@ namespace GraphInf
         if (initialActive < 0 or initialActive > N)
             return Dynamics::getRandomState();
 
-        auto indices = sampleUniformlySequenceWithoutReplacement(N, initialActive);
+        auto indices = sampleUniformlySequenceWithoutReplacement(N, initialActive, *m_rngPtr);
         for (auto i : indices)
             randomState[i] = 1;
         return randomState;
     };
 
+    void BinaryDynamics::computeLogTransitionTable()
+    {
+        m_logTransitionTable.clear();
+        m_tableInactiveSize = m_tableActiveSize = 0;
+        if (not m_cacheLogLikelihood)
+            return;
+
+        // Room for the neighbourhoods to double in size under graph moves.
+        size_t maxDegree = 0;
+        const auto &graph = getGraph();
+        for (auto vertex : graph)
+            maxDegree = std::max(maxDegree, graph.getDegree(vertex));
+        m_tableActiveSize = 2 * maxDegree + 1;
+        m_tableDependsOnInactive = dependsOnInactiveNeighbors();
+        if (m_tableDependsOnInactive)
+        {
+            m_tableActiveSize = std::min(m_tableActiveSize, (size_t)std::sqrt(MAX_TABLE_SIZE));
+            m_tableInactiveSize = m_tableActiveSize;
+        }
+        else
+        {
+            m_tableActiveSize = std::min(m_tableActiveSize, MAX_TABLE_SIZE);
+            m_tableInactiveSize = 1;
+        }
+
+        m_logTransitionTable.resize(4 * m_tableInactiveSize * m_tableActiveSize);
+        VertexNeighborhoodState neighborhoodState(2);
+        for (size_t inactive = 0; inactive < m_tableInactiveSize; inactive++)
+            for (size_t active = 0; active < m_tableActiveSize; active++)
+            {
+                neighborhoodState[0] = inactive;
+                neighborhoodState[1] = active;
+                for (VertexState prev = 0; prev < 2; prev++)
+                    for (VertexState next = 0; next < 2; next++)
+                        m_logTransitionTable[4 * (inactive * m_tableActiveSize + active) + 2 * prev + next] = log(getTransitionProb(prev, next, neighborhoodState));
+            }
+    }
+
+    const double BinaryDynamics::computeVertexLogLikelihood(BaseGraph::VertexIndex vertex, const GraphMove &move, size_t first, size_t length) const
+    {
+        if (m_logTransitionTable.empty())
+            return Dynamics::computeVertexLogLikelihood(vertex, move, first, length);
+        const auto sequences = getVertexSequences(vertex, first, length);
+        if (sequences.stride != 1 or sequences.countStride != 2)
+            return Dynamics::computeVertexLogLikelihood(vertex, move, first, length);
+        const auto shifts = getNeighborShifts(vertex, move, first, length);
+
+        const LogTransitionTable table = {
+            m_logTransitionTable.data(),
+            m_tableDependsOnInactive ? (int)m_tableActiveSize : 0,
+            m_tableDependsOnInactive ? (int)m_tableInactiveSize : std::numeric_limits<int>::max(),
+            (int)m_tableActiveSize};
+        double logLikelihood;
+        if (sumLogTransitions(table, sequences.pastStates, sequences.futureStates, sequences.neighborCounts,
+                              shifts.data(), shifts.size(), length, logLikelihood))
+            return logLikelihood;
+        return Dynamics::computeVertexLogLikelihood(vertex, move, first, length);
+    }
+
     const double BinaryDynamics::getTransitionProb(
         const VertexState &prevVertexState, const VertexState &nextVertexState, const VertexNeighborhoodState &neighborhoodState) const
     {
@@ -12,11 +12,359 @@ namespace GraphInf
         }
         if (m_state.size() != 0)
             m_neighborsState = computeNeighborsState(m_state);
-        if (m_pastStateSequence.size() != 0)
+        if (m_packStates)
+            m_length = m_packedPastStates.getLength() - m_isTrajectory;
+        else if (m_pastStateSequence.size() != 0)
         {
-            m_neighborsPastStateSequence = computeNeighborsStateSequence(m_pastStateSequence);
-            m_length = m_pastStateSequence[0].size();
+            m_length = m_pastStateSequence.getLength() - m_isTrajectory;
+            if (storesNeighborsPastStates())
+                computeNeighborsStateSequence(m_pastStateSequence, m_length, m_neighborsPastStateSequence);
+            else
+                m_neighborsPastStateSequence.clear();
+        }
+        m_transitionCounts = computeTransitionCounts();
+        computeLogLikelihoodCache();
+    }
+
+    void Dynamics::setState(const Matrix<VertexState> &states)
+    {
+        const size_t N = states.size();
+        const size_t length = (N == 0 or states[0].size() == 0) ? 0 : states[0].size() - 1;
+        resizeStateSequences(N, length, true);
+        for (size_t v = 0; v < N; v++)
+        {
+            if (states[v].size() != length + 1)
+                throw std::logic_error("Dynamics: trajectory of vertex " + std::to_string(v) + " has " + std::to_string(states[v].size()) + " states, expected " + std::to_string(length + 1) + ".");
+            if (m_packStates)
+                m_packedPastStates.pack(v, states[v].data(), 0, length + 1);
+            else
+                for (size_t t = 0; t <= length; t++)
+                    *m_pastStateSequence.at(v, t) = states[v][t];
+        }
+        computeConsistentState();
+    }
+
+    void Dynamics::setState(const Matrix<VertexState> &past, const Matrix<VertexState> &future)
+    {
+        const size_t N = past.size();
+        const size_t length = (N == 0) ? 0 : past[0].size();
+        bool isTrajectory = length > 0 and future.size() == N;
+        for (size_t v = 0; v < N and isTrajectory; v++)
+            isTrajectory = past[v].size() == length and future[v].size() == length and std::equal(past[v].begin() + 1, past[v].end(), future[v].begin());
+        if (not isTrajectory)
+        {
+            resizeStateSequences(0, 0, false);
+            if (m_packStates)
+            {
+                m_packedPastStates.assign(past);
+                m_packedFutureStates.assign(future);
+            }
+            else
+            {
+                m_pastStateSequence.assign(past);
+                m_futureStateSequence.assign(future);
+            }
+            computeConsistentState();
+            return;
+        }
+
+        resizeStateSequences(N, length, true);
+        for (size_t v = 0; v < N; v++)
+        {
+            if (m_packStates)
+            {
+                m_packedPastStates.pack(v, past[v].data(), 0, length);
+                m_packedPastStates.pack(v, future[v].data() + length - 1, length, 1);
+                continue;
+            }
+            for (size_t t = 0; t < length; t++)
+                *m_pastStateSequence.at(v, t) = past[v][t];
+            *m_pastStateSequence.at(v, length) = future[v][length - 1];
+        }
+        computeConsistentState();
+    }
+
+    void Dynamics::setStateFromFile(const std::string &path, SequenceLayout layout)
+    {
+        const auto file = std::make_shared<const MappedStateFile>(path);
+        const auto &shape = file->getShape();
+        const size_t N = DataModel::getSize();
+        size_t numSteps;
+        if (shape.size() == 1 and N > 0 and shape[0] % N == 0)
+            numSteps = shape[0] / N;
+        else if (shape.size() == 2 and shape[(layout == SequenceLayout::VertexMajor) ? 0 : 1] == N)
+            numSteps = shape[(layout == SequenceLayout::VertexMajor) ? 1 : 0];
+        else
+            throw std::logic_error("Dynamics: `" + path + "` holds " + std::to_string(file->size()) + " states, which do not form trajectories of the " + std::to_string(N) + " vertices.");
+        if (numSteps == 0)
+            throw std::logic_error("Dynamics: `" + path + "` holds no state.");
+        // States index the neighbour counts and transition tables, so they are checked before use.
+        const VertexState *states = file->data();
+        for (size_t i = 0; i < N * numSteps; i++)
+            if (states[i] < 0 or size_t(states[i]) >= m_numStates)
+                throw std::logic_error("Dynamics: `" + path + "` holds state " + std::to_string(states[i]) + " at index " + std::to_string(i) + ", expected a state in [0, " + std::to_string(m_numStates) + ").");
+
+        resizeStateSequences(0, 0, true);
+        setSequenceLayout(layout);
+        if (m_packStates)
+        {
+            SequenceArena<VertexState> states;
+            states.assignExternal(file->data(), N, numSteps, layout, file);
+            m_packedPastStates.assign(states);
+        }
+        else
+            m_pastStateSequence.assignExternal(file->data(), N, numSteps, layout, file);
+        // The current state is the last one of the trajectory, unless already set.
+        if (m_state.size() != N)
+        {
+            m_state.resize(N);
+            for (size_t v = 0; v < N; v++)
+                m_state[v] = m_packStates ? m_packedPastStates.get(v, numSteps - 1) : file->data()[(layout == SequenceLayout::VertexMajor) ? v * numSteps + numSteps - 1 : (numSteps - 1) * N + v];
+        }
+        computeConsistentState();
+    }
+
+    void Dynamics::appendStates(const Matrix<VertexState> &states, size_t maxLength)
+    {
+        const size_t N = DataModel::getSize();
+        if (not hasStateSequences())
+            throw std::logic_error("Dynamics: cannot append states to a dynamics without sequences.");
+        if (states.size() != N)
+            throw std::logic_error("Dynamics: cannot append the states of " + std::to_string(states.size()) + " vertices, expected " + std::to_string(N) + ".");
+        const size_t numSteps = (N == 0) ? 0 : states[0].size();
+        for (size_t v = 0; v < N; v++)
+            if (states[v].size() != numSteps)
+                throw std::logic_error("Dynamics: " + std::to_string(states[v].size()) + " new states for vertex " + std::to_string(v) + ", expected " + std::to_string(numSteps) + ".");
+        if (not m_isTrajectory)
+        {
+            // The new transitions start from the last future states.
+            if (numSteps > 0 and m_length == 0)
+                throw std::logic_error("Dynamics: cannot append states after an empty sequence of transitions.");
+            const auto futureStates = getFutureStates();
+            Matrix<VertexState> past(N);
+            for (size_t v = 0; v < N; v++)
+                if (numSteps > 0)
+                {
+                    past[v].push_back(futureStates[v][m_length - 1]);
+                    past[v].insert(past[v].end(), states[v].begin(), states[v].end() - 1);
+                }
+            appendStates(past, states, maxLength);
+            return;
+        }
+
+        const size_t first = m_length;
+        if (m_packStates)
+            m_packedPastStates.setLength(first + numSteps + 1);
+        else
+            m_pastStateSequence.setLength(first + numSteps + 1);
+        m_length = first + numSteps;
+        for (size_t v = 0; v < N; v++)
+            for (size_t k = 0; k < numSteps; k++)
+                setFutureState(v, first + k, states[v][k]);
+        if (storesNeighborsPastStates())
+        {
+            m_neighborsPastStateSequence.setLength(m_length);
+            computeNeighborsStateSequence(m_pastStateSequence, first, numSteps, m_neighborsPastStateSequence);
         }
+        updateLogLikelihoodCache(1, first, numSteps);
+        if (maxLength > 0 and m_length > maxLength)
+            evictFrontSteps(m_length - maxLength);
+#if DEBUG
+        checkSelfConsistency();
+#endif
+    }
+
+    void Dynamics::appendStates(const Matrix<VertexState> &past, const Matrix<VertexState> &future, size_t maxLength)
+    {
+        const size_t N = DataModel::getSize();
+        if (not hasStateSequences())
+            throw std::logic_error("Dynamics: cannot append states to a dynamics without sequences.");
+        if (past.size() != N or future.size() != N)
+            throw std::logic_error("Dynamics: cannot append the states of " + std::to_string(past.size()) + " and " + std::to_string(future.size()) + " vertices, expected " + std::to_string(N) + ".");
+        const size_t numSteps = (N == 0) ? 0 : past[0].size();
+        for (size_t v = 0; v < N; v++)
+            if (past[v].size() != numSteps or future[v].size() != numSteps)
+                throw std::logic_error("Dynamics: new past and future states of vertex " + std::to_string(v) + " have different lengths.");
+
+        if (m_isTrajectory)
+        {
+            const auto &pastStates = m_pastStateSequence;
+            bool continues = true;
+            for (size_t v = 0; v < N and continues and numSteps > 0; v++)
+            {
+                const VertexState last = m_packStates ? m_packedPastStates.get(v, m_length) : *pastStates.at(v, m_length);
+                continues = past[v][0] == last and std::equal(past[v].begin() + 1, past[v].end(), future[v].begin());
+            }
+            if (continues)
+            {
+                appendStates(future, maxLength);
+                return;
+            }
+            // The future sequence becomes a copy of the trajectory shifted by one step.
+            m_isTrajectory = false;
+            if (m_packStates)
+            {
+                m_packedFutureStates.resize(N, m_length);
+                for (size_t v = 0; v < N; v++)
+                    for (size_t t = 0; t < m_length; t++)
+                        m_packedFutureStates.set(v, t, m_packedPastStates.get(v, t + 1));
+                m_packedPastStates.setLength(m_length);
+            }
+            else
+            {
+                m_futureStateSequence.resize(N, m_length);
+                for (size_t v = 0; v < N; v++)
+                    for (size_t t = 0; t < m_length; t++)
+                        *m_futureStateSequence.at(v, t) = *pastStates.at(v, t + 1);
+                m_pastStateSequence.setLength(m_length);
+            }
+        }
+
+        const size_t first = m_length;
+        m_length = first + numSteps;
+        if (m_packStates)
+        {
+            m_packedPastStates.setLength(m_length);
+            m_packedFutureStates.setLength(m_length);
+        }
+        else
+        {
+            m_pastStateSequence.setLength(m_length);
+            m_futureStateSequence.setLength(m_length);
+        }
+        for (size_t v = 0; v < N; v++)
+            for (size_t k = 0; k < numSteps; k++)
+            {
+                setPastState(v, first + k, past[v][k]);
+                setFutureState(v, first + k, future[v][k]);
+            }
+        if (storesNeighborsPastStates())
+        {
+            m_neighborsPastStateSequence.setLength(m_length);
+            computeNeighborsStateSequence(m_pastStateSequence, first, numSteps, m_neighborsPastStateSequence);
+        }
+        updateLogLikelihoodCache(1, first, numSteps);
+        if (maxLength > 0 and m_length > maxLength)
+            evictFrontSteps(m_length - maxLength);
+#if DEBUG
+        checkSelfConsistency();
+#endif
+    }
+
+    void Dynamics::evictFrontSteps(size_t count)
+    {
+        updateLogLikelihoodCache(-1, 0, count);
+        if (m_packStates)
+        {
+            m_packedPastStates.eraseFront(count);
+            m_packedFutureStates.eraseFront(count);
+        }
+        else
+        {
+            m_pastStateSequence.eraseFront(count);
+            m_futureStateSequence.eraseFront(count);
+        }
+        m_neighborsPastStateSequence.eraseFront(count);
+        m_length -= count;
+
+        // Removed terms leave rounding errors in the cached sums, cleared by a full pass once per window turnover.
+        m_numEvictedSinceRefresh += count;
+        if (m_numEvictedSinceRefresh >= m_length)
+        {
+            computeLogLikelihoodCache();
+            m_numEvictedSinceRefresh = 0;
+        }
+    }
+
+    void Dynamics::updateLogLikelihoodCache(int counter, size_t first, size_t length)
+    {
+        if (not isLogLikelihoodCached() or length == 0)
+            return;
+        const size_t N = DataModel::getSize();
+        m_logLikelihood += counter * parallelSum(m_threadPool.get(), N, VERTEX_BLOCK_SIZE, [&](size_t vertex)
+                                                 {
+                                                     const double logLikelihood = computeVertexLogLikelihood(vertex, {}, first, length);
+                                                     // Stale values are recomputed over the whole window when read.
+                                                     if (not isVertexLogLikelihoodStale(vertex))
+                                                         m_vertexLogLikelihoods[vertex] += counter * logLikelihood;
+                                                     return logLikelihood; });
+
+        // As in computeTransitionCounts, each block fills a map of its own.
+        const size_t blockSize = 16 * VERTEX_BLOCK_SIZE;
+        std::vector<TransitionCounts> blockCounts((N + blockSize - 1) / blockSize);
+        parallelForBlocks(m_threadPool.get(), N, blockSize, [&](size_t begin, size_t end)
+                          {
+                              for (BaseGraph::VertexIndex vertex = begin; vertex < end; vertex++)
+                                  updateTransitionCounts(vertex, 1, blockCounts[begin / blockSize], {}, first, length); });
+        for (const auto &counts : blockCounts)
+            for (const auto &transition : counts)
+            {
+                if (counter > 0)
+                {
+                    m_transitionCounts[transition.first] += transition.second;
+                    continue;
+                }
+                auto it = m_transitionCounts.find(transition.first);
+                if (it == m_transitionCounts.end() or it->second < transition.second)
+                    throw std::logic_error("Dynamics: cannot remove transitions absent from the transition counts.");
+                if ((it->second -= transition.second) == 0)
+                    m_transitionCounts.erase(it);
+            }
+    }
+
+    void Dynamics::resizeStateSequences(size_t size, size_t length, bool isTrajectory)
+    {
+        m_isTrajectory = isTrajectory;
+        const size_t futureSize = isTrajectory ? 0 : size;
+        if (m_packStates)
+        {
+            m_packedPastStates.resize(size, length + isTrajectory);
+            m_packedFutureStates.resize(futureSize, length);
+            return;
+        }
+        m_pastStateSequence.resize(size, length + isTrajectory);
+        m_futureStateSequence.resize(futureSize, length);
+        if (storesNeighborsPastStates())
+            m_neighborsPastStateSequence.resize(size, length);
+    }
+
+    void Dynamics::setNeighborsPastStateCaching(bool cache)
+    {
+        m_cacheNeighborsPastStates = cache;
+        if (storesNeighborsPastStates() and m_pastStateSequence.size() != 0)
+            computeNeighborsStateSequence(m_pastStateSequence, m_length, m_neighborsPastStateSequence);
+        else
+            m_neighborsPastStateSequence.clear();
+    }
+
+    void Dynamics::setStatePacking(bool pack)
+    {
+        if (pack == m_packStates)
+            return;
+        if (pack and m_numStates != 2)
+            throw std::logic_error("Dynamics: cannot pack the states of a dynamics with " + std::to_string(m_numStates) + " states.");
+        if (pack)
+        {
+            m_packedPastStates.assign(m_pastStateSequence);
+            m_packedFutureStates.assign(m_futureStateSequence);
+            m_pastStateSequence.clear();
+            m_futureStateSequence.clear();
+            m_neighborsPastStateSequence.clear();
+        }
+        else
+        {
+            m_pastStateSequence.resize(m_packedPastStates.size(), m_packedPastStates.getLength());
+            m_futureStateSequence.resize(m_packedFutureStates.size(), m_packedFutureStates.getLength());
+            for (size_t v = 0; v < m_pastStateSequence.size(); v++)
+                m_packedPastStates.unpack(v, m_pastStateSequence.at(v, 0), 0, m_pastStateSequence.getLength(), m_pastStateSequence.getTimeStride());
+            for (size_t v = 0; v < m_futureStateSequence.size(); v++)
+                m_packedFutureStates.unpack(v, m_futureStateSequence.at(v, 0), 0, m_futureStateSequence.getLength(), m_futureStateSequence.getTimeStride());
+            if (m_pastStateSequence.size() != 0 and m_cacheNeighborsPastStates)
+                computeNeighborsStateSequence(m_pastStateSequence, m_length, m_neighborsPastStateSequence);
+            m_packedPastStates.clear();
+            m_packedFutureStates.clear();
+        }
+        m_packStates = pack;
     }
 
     void Dynamics::sampleState(const State &x0, bool asyncMode, size_t initialBurn)
@@ -28,10 +376,8 @@ namespace GraphInf
 
         m_neighborsState = computeNeighborsState(m_state);
 
-        StateSequence reversedPastState;
-        StateSequence reversedFutureState;
-        NeighborsStateSequence reversedNeighborsPastState;
-
+        // Synchronous steps share one key and differ by their counter.
+        const uint64_t key = (*m_rngPtr)();
         for (size_t t = 0; t < initialBurn; t++)
         {
             if (asyncMode)
@@ -40,45 +386,165 @@ namespace GraphInf
             }
             else
             {
-                syncUpdateState();
+                syncUpdateStateFromKey(key, t);
             }
         }
 
+        const auto N = DataModel::getSize();
+        resizeStateSequences(N, m_length, true);
         for (size_t t = 0; t < m_length; t++)
         {
-            reversedPastState.push_back(m_state);
-            reversedNeighborsPastState.push_back(m_neighborsState);
+            for (size_t idx = 0; idx < N; idx++)
+            {
+                setPastState(idx, t, m_state[idx]);
+                if (storesNeighborsPastStates())
+                    std::copy(m_neighborsState[idx].begin(), m_neighborsState[idx].end(), m_neighborsPastStateSequence.at(idx, t));
+            }
             if (asyncMode)
             {
                 asyncUpdateState(DataModel::getSize());
             }
             else
             {
-                syncUpdateState();
+                syncUpdateStateFromKey(key, initialBurn + t);
             }
-            reversedFutureState.push_back(m_state);
+            for (size_t idx = 0; idx < N; idx++)
+                setFutureState(idx, t, m_state[idx]);
         }
+        m_transitionCounts = computeTransitionCounts();
+        computeLogLikelihoodCache();
+
+#if DEBUG
+        checkSelfConsistency();
+#endif
+    }
 
+    const double Dynamics::getLeaveRate(BaseGraph::VertexIndex vertex) const
+    {
+        const double stayProb = getTransitionProb(m_state[vertex], m_state[vertex], m_neighborsState[vertex]);
+        return (stayProb >= 1) ? 0 : -log(std::max(stayProb, std::numeric_limits<double>::min()));
+    }
+
+    const VertexState Dynamics::sampleStateAfterLeaving(BaseGraph::VertexIndex vertex, double uniform) const
+    {
+        static thread_local std::vector<double> cumulativeProbs;
+        cumulativeProbs.resize(m_numStates);
+        double totalProb = 0;
+        for (VertexState nextVertexState = 0; nextVertexState < m_numStates; nextVertexState++)
+        {
+            if (nextVertexState != m_state[vertex])
+                totalProb += getTransitionProb(m_state[vertex], nextVertexState, m_neighborsState[vertex]);
+            cumulativeProbs[nextVertexState] = totalProb;
+        }
+        // The current state spans an empty interval, so it is never drawn unless all the others have probability 0.
+        const auto it = std::upper_bound(cumulativeProbs.begin(), cumulativeProbs.end(), uniform * totalProb);
+        return std::min<VertexState>(it - cumulativeProbs.begin(), m_numStates - 1);
+    }
+
+    void Dynamics::sampleStateFromEvents(const State &x0, double initialBurn)
+    {
+        m_state = (x0.size() == 0) ? getRandomState() : x0;
+        m_neighborsState = computeNeighborsState(m_state);
         const auto N = DataModel::getSize();
         const auto &graph = DataModel::getGraph();
-        m_pastStateSequence.clear();
-        m_pastStateSequence.resize(N);
-        m_futureStateSequence.clear();
-        m_futureStateSequence.resize(N);
-        m_neighborsPastStateSequence.clear();
-        m_neighborsPastStateSequence.resize(N);
-        for (const auto &idx : graph)
-        {
-            m_pastStateSequence[idx].resize(m_length);
-            m_futureStateSequence[idx].resize(m_length);
-            m_neighborsPastStateSequence[idx].resize(m_length);
-            for (size_t t = 0; t < m_length; t++)
+
+        SumTree rates(N);
+        for (BaseGraph::VertexIndex vertex = 0; vertex < N; vertex++)
+            rates.set(vertex, getLeaveRate(vertex));
+
+        /* Changes of state, by vertex, as (first reading that sees it, new
+         * state), and of neighbour counts, as (first reading, vertex, old
+         * state, new state). The readings are at initialBurn + k for
+         * k = 0, ..., T, the last one only giving future states. */
+        struct Event
+        {
+            size_t reading;
+            BaseGraph::VertexIndex vertex;
+            VertexState prevVertexState, nextVertexState;
+        };
+        std::vector<Event> events;
+        State initialState;
+        NeighborsState initialNeighborsState;
+        std::exponential_distribution<double> waitingTime(1);
+        std::uniform_real_distribution<double> uniform(0, 1);
+        double time = 0;
+        while (true)
+        {
+            const double totalRate = rates.getTotal();
+            time += (totalRate > 0) ? waitingTime(*m_rngPtr) / totalRate : std::numeric_limits<double>::infinity();
+            if (initialState.size() == 0 and time > initialBurn)
             {
-                m_pastStateSequence[idx][t] = reversedPastState[t][idx];
-                m_futureStateSequence[idx][t] = reversedFutureState[t][idx];
-                m_neighborsPastStateSequence[idx][t] = reversedNeighborsPastState[t][idx];
+                initialState = m_state;
+                initialNeighborsState = m_neighborsState;
+            }
+            if (time > initialBurn + m_length)
+                break;
+
+            const BaseGraph::VertexIndex vertex = rates.sample(uniform(*m_rngPtr));
+            const VertexState prevVertexState = m_state[vertex];
+            const VertexState nextVertexState = sampleStateAfterLeaving(vertex, uniform(*m_rngPtr));
+            if (initialState.size() != 0)
+                events.push_back({(size_t)std::ceil(time - initialBurn), vertex, prevVertexState, nextVertexState});
+            updateNeighborsStateInPlace(vertex, prevVertexState, nextVertexState, m_neighborsState);
+            m_state[vertex] = nextVertexState;
+            rates.set(vertex, getLeaveRate(vertex));
+            for (auto neighbor : graph.getOutNeighbours(vertex))
+                rates.set(neighbor, getLeaveRate(neighbor));
+        }
+
+        // Every reading repeats the previous one but for the events in between.
+        resizeStateSequences(N, m_length, true);
+        std::vector<std::vector<std::pair<size_t, VertexState>>> stateChanges(N);
+        for (const auto &event : events)
+        {
+            stateChanges[event.vertex].push_back({event.reading, event.nextVertexState});
+            if (event.reading >= m_length or not storesNeighborsPastStates())
+                continue;
+            for (auto neighbor : graph.getOutNeighbours(event.vertex))
+            {
+                size_t mult = graph.getEdgeMultiplicity(event.vertex, neighbor);
+                if (event.vertex == neighbor)
+                {
+                    if (m_acceptSelfLoops)
+                        mult *= 2;
+                    else
+                        continue;
+                }
+                m_neighborsPastStateSequence.at(neighbor, event.reading)[event.prevVertexState] -= mult;
+                m_neighborsPastStateSequence.at(neighbor, event.reading)[event.nextVertexState] += mult;
             }
         }
+        parallelForBlocks(m_threadPool.get(), N, VERTEX_BLOCK_SIZE, [&](size_t begin, size_t end)
+                          {
+                              for (BaseGraph::VertexIndex vertex = begin; vertex < end; vertex++)
+                              {
+                                  VertexState vertexState = initialState[vertex];
+                                  auto change = stateChanges[vertex].begin();
+                                  for (size_t t = 0; t <= m_length; t++)
+                                  {
+                                      for (; change != stateChanges[vertex].end() and change->first == t; ++change)
+                                          vertexState = change->second;
+                                      if (t < m_length)
+                                          setPastState(vertex, t, vertexState);
+                                      if (t > 0)
+                                          setFutureState(vertex, t - 1, vertexState);
+                                  }
+
+                                  if (m_length == 0 or not storesNeighborsPastStates())
+                                      continue;
+                                  VertexState *counts = m_neighborsPastStateSequence.at(vertex, 0);
+                                  for (size_t s = 0; s < m_numStates; s++)
+                                      counts[s] += initialNeighborsState[vertex][s];
+                                  for (size_t t = 1; t < m_length; t++)
+                                  {
+                                      VertexState *nextCounts = m_neighborsPastStateSequence.at(vertex, t);
+                                      for (size_t s = 0; s < m_numStates; s++)
+                                          nextCounts[s] += counts[s];
+                                      counts = nextCounts;
+                                  }
+                              } });
+        m_transitionCounts = computeTransitionCounts();
+        computeLogLikelihoodCache();
 
 #if DEBUG
         checkSelfConsistency();
@@ -92,7 +558,7 @@ namespace GraphInf
         std::uniform_int_distribution<size_t> dist(0, m_numStates - 1);
 
         for (size_t i = 0; i < N; i++)
-            rnd_state[i] = dist(rng);
+            rnd_state[i] = dist(*m_rngPtr);
 
         return rnd_state;
     };
@@ -101,55 +567,72 @@ namespace GraphInf
     {
         const auto N = DataModel::getSize();
         const auto &graph = DataModel::getGraph();
-        NeighborsState neighborsState(N);
-        for (auto vertex : graph)
-        {
-            neighborsState[vertex].resize(m_numStates);
-            for (auto neighbor : graph.getOutNeighbours(vertex))
-            {
-                size_t mult = graph.getEdgeMultiplicity(vertex, neighbor);
-                if (vertex == neighbor)
-                {
-                    if (m_acceptSelfLoops)
-                        mult *= 2;
-                    else
-                        continue;
-                }
-
-                neighborsState[vertex][state[neighbor]] += mult;
-            }
-        }
+        NeighborsState neighborsState(N, VertexNeighborhoodState(m_numStates, 0));
+        parallelForBlocks(m_threadPool.get(), N, VERTEX_BLOCK_SIZE, [&](size_t begin, size_t end)
+                          {
+                              for (BaseGraph::VertexIndex vertex = begin; vertex < end; vertex++)
+                                  for (auto neighbor : graph.getOutNeighbours(vertex))
+                                  {
+                                      size_t mult = graph.getEdgeMultiplicity(vertex, neighbor);
+                                      if (vertex == neighbor)
+                                      {
+                                          if (m_acceptSelfLoops)
+                                              mult *= 2;
+                                          else
+                                              continue;
+                                      }
+                                      neighborsState[vertex][state[neighbor]] += mult;
+                                  } });
         return neighborsState;
     };
 
     const NeighborsStateSequence Dynamics::computeNeighborsStateSequence(const StateSequence &stateSequence) const
     {
+        SequenceArena<VertexState> states, neighborsStates(m_numStates);
+        states.assign(stateSequence);
+        computeNeighborsStateSequence(states, states.getLength(), neighborsStates);
+        return CellSequenceView<VertexState>(neighborsStates);
+    };
 
-        const auto N = DataModel::getSize();
+    void Dynamics::computeNeighborsStateSequence(
+        const SequenceArena<VertexState> &stateSequence,
+        size_t length,
+        SequenceArena<VertexState> &neighborsStateSequence) const
+    {
+        neighborsStateSequence.resize(DataModel::getSize(), length);
+        computeNeighborsStateSequence(stateSequence, 0, length, neighborsStateSequence);
+    }
+
+    void Dynamics::computeNeighborsStateSequence(
+        const SequenceArena<VertexState> &stateSequence,
+        size_t first,
+        size_t length,
+        SequenceArena<VertexState> &neighborsStateSequence) const
+    {
         const auto &graph = DataModel::getGraph();
-        NeighborsStateSequence neighborsStateSequence(N);
-        for (const auto &vertex : graph)
-        {
-            neighborsStateSequence[vertex].resize(m_length);
-            for (size_t t = 0; t < m_length; t++)
-            {
-                neighborsStateSequence[vertex][t].resize(m_numStates);
-                for (const auto &neighbor : graph.getOutNeighbours(vertex))
-                {
-                    size_t edgeMult = graph.getEdgeMultiplicity(vertex, neighbor);
-                    if (vertex == neighbor)
-                    {
-                        if (m_acceptSelfLoops)
-                            edgeMult *= 2;
-                        else
-                            continue;
-                    }
-                    neighborsStateSequence[vertex][t][stateSequence[neighbor][t]] += edgeMult;
-                }
-            }
-        }
-        return neighborsStateSequence;
-    };
+        const size_t stateStride = stateSequence.getTimeStride();
+        const size_t neighborsStride = neighborsStateSequence.getTimeStride();
+        parallelForBlocks(m_threadPool.get(), graph.getSize(), VERTEX_BLOCK_SIZE, [&](size_t begin, size_t end)
+                          {
+                              for (BaseGraph::VertexIndex vertex = begin; vertex < end; vertex++)
+                              {
+                                  VertexState *neighborsStates = neighborsStateSequence.at(vertex, first);
+                                  for (const auto &neighbor : graph.getOutNeighbours(vertex))
+                                  {
+                                      size_t edgeMult = graph.getEdgeMultiplicity(vertex, neighbor);
+                                      if (vertex == neighbor)
+                                      {
+                                          if (m_acceptSelfLoops)
+                                              edgeMult *= 2;
+                                          else
+                                              continue;
+                                      }
+                                      const VertexState *neighborStates = stateSequence.at(neighbor, first);
+                                      for (size_t t = 0; t < length; t++)
+                                          neighborsStates[t * neighborsStride + neighborStates[t * stateStride]] += edgeMult;
+                                  }
+                              } });
+    }
 
     void Dynamics::updateNeighborsStateInPlace(
         BaseGraph::VertexIndex vertex,
@@ -175,19 +658,21 @@ namespace GraphInf
         }
     };
 
-    void Dynamics::syncUpdateState()
+    void Dynamics::syncUpdateStateFromKey(uint64_t key, size_t step)
     {
+        const size_t N = DataModel::getSize();
         State futureState(m_state);
-        std::vector<double> transProbs(m_numStates);
-        const auto &graph = DataModel::getGraph();
-
-        for (const auto idx : graph)
-        {
-            transProbs = getTransitionProbs(idx);
-            futureState[idx] = generateCategorical<double, size_t>(transProbs);
-        }
-        for (const auto idx : graph)
-            updateNeighborsStateInPlace(idx, m_state[idx], futureState[idx], m_neighborsState);
+        ThreadPool &threadPool = m_threadPool.get();
+        parallelForBlocks(threadPool, N, VERTEX_BLOCK_SIZE, [&](size_t begin, size_t end)
+                          {
+                              for (BaseGraph::VertexIndex vertex = begin; vertex < end; vertex++)
+                                  futureState[vertex] = sampleNextState(m_state[vertex], m_neighborsState[vertex], Philox4x32::uniform(key, step, vertex)); });
+        // The incremental update writes to the neighbours, so threads recount instead.
+        if (threadPool.getThreadCount() > 1)
+            m_neighborsState = computeNeighborsState(futureState);
+        else
+            for (BaseGraph::VertexIndex vertex = 0; vertex < N; vertex++)
+                updateNeighborsStateInPlace(vertex, m_state[vertex], futureState[vertex], m_neighborsState);
         m_state = futureState;
     };
 
@@ -196,14 +681,13 @@ namespace GraphInf
         size_t N = DataModel::getSize();
         VertexState newVertexState;
         State currentState(m_state);
-        std::vector<double> transProbs(m_numStates);
         std::uniform_int_distribution<BaseGraph::VertexIndex> idxGenerator(0, N - 1);
+        std::uniform_real_distribution<double> uniform(0, 1);
 
         for (auto i = 0; i < numUpdates; i++)
         {
-            BaseGraph::VertexIndex idx = idxGenerator(rng);
-            transProbs = getTransitionProbs(currentState[idx], m_neighborsState[idx]);
-            newVertexState = generateCategorical<double, size_t>(transProbs);
+            BaseGraph::VertexIndex idx = idxGenerator(*m_rngPtr);
+            newVertexState = sampleNextState(currentState[idx], m_neighborsState[idx], uniform(*m_rngPtr));
             updateNeighborsStateInPlace(idx, currentState[idx], newVertexState, m_neighborsState);
             currentState[idx] = newVertexState;
         }
@@ -212,20 +696,10 @@ namespace GraphInf
 
     const double Dynamics::getLogLikelihood() const
     {
-        double logLikelihood = 0;
-        std::vector<int> neighborsState(getNumStates(), 0);
-        const auto &graph = DataModel::getGraph();
-        for (size_t t = 0; t < m_length; t++)
-        {
-            for (auto idx : graph)
-            {
-                logLikelihood += log(getTransitionProb(
-                    m_pastStateSequence[idx][t],
-                    m_futureStateSequence[idx][t],
-                    m_neighborsPastStateSequence[idx][t]));
-            }
-        }
-        return logLikelihood;
+        if (isLogLikelihoodCached())
+            return m_logLikelihood;
+        return parallelSum(m_threadPool.get(), DataModel::getSize(), VERTEX_BLOCK_SIZE, [&](size_t vertex)
+                           { return computeVertexLogLikelihood(vertex); });
     };
 
     const std::vector<double> Dynamics::getTransitionProbs(const VertexState &prevVertexState, const VertexNeighborhoodState &neighborhoodState) const
@@ -237,106 +711,364 @@ namespace GraphInf
         }
         return transProbs;
     };
+    const VertexState Dynamics::sampleNextState(
+        const VertexState &prevVertexState, const VertexNeighborhoodState &neighborhoodState, double uniform) const
+    {
+        static thread_local std::vector<double> cumulativeProbs;
+        cumulativeProbs.resize(m_numStates);
+        double totalProb = 0;
+        for (VertexState nextVertexState = 0; nextVertexState < m_numStates; nextVertexState++)
+        {
+            totalProb += getTransitionProb(prevVertexState, nextVertexState, neighborhoodState);
+            cumulativeProbs[nextVertexState] = totalProb;
+        }
+        const auto it = std::upper_bound(cumulativeProbs.begin(), cumulativeProbs.end(), uniform * totalProb);
+        return std::min<VertexState>(it - cumulativeProbs.begin(), m_numStates - 1);
+    }
+
     const std::vector<std::vector<double>> Dynamics::getTransitionMatrix(VertexState outState) const
     {
         std::vector<std::vector<double>> probs;
+        VertexNeighborhoodState neighborsState(getNumStates(), 0);
         for (auto idx : getGraph())
         {
             probs.push_back({});
+            const auto sequences = getVertexSequences(idx);
             for (size_t t = 0; t < m_length; t++)
             {
                 VertexState futureState = outState;
                 if (outState == -1)
-                    futureState = m_futureStateSequence[idx][t];
+                    futureState = sequences.futureStates[t * sequences.stride];
+                const VertexState *counts = sequences.neighborCounts + t * sequences.countStride;
+                std::copy(counts, counts + m_numStates, neighborsState.begin());
                 probs[idx].push_back(getTransitionProb(
-                    m_pastStateSequence[idx][t],
+                    sequences.pastStates[t * sequences.stride],
                     futureState,
-                    m_neighborsPastStateSequence[idx][t]));
+                    neighborsState));
             }
         }
         return probs;
     };
 
-    void Dynamics::updateNeighborsStateFromEdgeMove(
-        BaseGraph::Edge edge,
-        int counter,
-        std::map<BaseGraph::VertexIndex, VertexNeighborhoodStateSequence> &prevNeighborMap,
-        std::map<BaseGraph::VertexIndex, VertexNeighborhoodStateSequence> &nextNeighborMap) const
+    void Dynamics::checkGraphMove(const GraphMove &move) const
     {
-        edge = getOrderedEdge(edge);
-        BaseGraph::VertexIndex v = edge.first, u = edge.second;
-        if (u == v and not m_acceptSelfLoops)
-            return;
         const auto &graph = DataModel::getGraph();
+        for (const auto &edge : move.removedEdges)
+            if ((edge.first != edge.second or m_acceptSelfLoops) and graph.getEdgeMultiplicity(edge.first, edge.second) == 0)
+                throw std::logic_error("Dynamics: Edge (" + std::to_string(edge.first) + ", " + std::to_string(edge.second) + ") " + "with multiplicity 0 cannot be removed.");
+    }
 
-        if (graph.getEdgeMultiplicity(edge.first, edge.second) == 0 and counter < 0)
-            throw std::logic_error("Dynamics: Edge (" + std::to_string(edge.first) + ", " + std::to_string(edge.second) + ") " + "with multiplicity 0 cannot be removed.");
+    const SmallVector<BaseGraph::VertexIndex, 4> Dynamics::getVerticesAffectedByGraphMove(const GraphMove &move) const
+    {
+        SmallVector<BaseGraph::VertexIndex, 4> verticesAffected;
+        const auto insertVertex = [&](BaseGraph::VertexIndex vertex)
+        {
+            if (std::find(verticesAffected.begin(), verticesAffected.end(), vertex) == verticesAffected.end())
+                verticesAffected.push_back(vertex);
+        };
+        for (const auto *edges : {&move.addedEdges, &move.removedEdges})
+            for (const auto &edge : *edges)
+            {
+                if (edge.first == edge.second and not m_acceptSelfLoops)
+                    continue;
+                insertVertex(edge.first);
+                insertVertex(edge.second);
+            }
+        return verticesAffected;
+    }
 
-        if (prevNeighborMap.count(v) == 0)
+    const Dynamics::VertexSequences Dynamics::getVertexSequences(BaseGraph::VertexIndex vertex, size_t first, size_t length) const
+    {
+        static thread_local std::vector<VertexState> pastStates, futureStates, neighborCounts;
+        if (not m_packStates)
         {
-            prevNeighborMap.insert({v, m_neighborsPastStateSequence[v]});
-            nextNeighborMap.insert({v, m_neighborsPastStateSequence[v]});
+            const VertexState *vertexPastStates = m_pastStateSequence.at(vertex, first);
+            const VertexState *vertexFutureStates = m_isTrajectory ? m_pastStateSequence.at(vertex, first + 1) : m_futureStateSequence.at(vertex, first);
+            const size_t stride = m_pastStateSequence.getTimeStride();
+            if (storesNeighborsPastStates())
+                return {vertexPastStates, vertexFutureStates, m_neighborsPastStateSequence.at(vertex, first), stride, m_neighborsPastStateSequence.getTimeStride()};
+
+            neighborCounts.assign(m_numStates * length, 0);
+            for (auto neighbor : DataModel::getGraph().getOutNeighbours(vertex))
+            {
+                const int weight = getNeighborWeight(vertex, neighbor);
+                if (weight == 0)
+                    continue;
+                const VertexState *neighborStates = m_pastStateSequence.at(neighbor, first);
+                for (size_t t = 0; t < length; t++)
+                    neighborCounts[t * m_numStates + neighborStates[t * stride]] += weight;
+            }
+            return {vertexPastStates, vertexFutureStates, neighborCounts.data(), stride, m_numStates};
         }
-        if (prevNeighborMap.count(u) == 0)
+
+        static thread_local std::vector<PackedVertexMask> masks;
+        pastStates.resize(length);
+        futureStates.resize(length);
+        neighborCounts.resize(2 * length);
+        m_packedPastStates.unpack(vertex, pastStates.data(), first, length);
+        if (m_isTrajectory)
+            m_packedPastStates.unpack(vertex, futureStates.data(), first + 1, length);
+        else
+            m_packedFutureStates.unpack(vertex, futureStates.data(), first, length);
+        getNeighborMasks(vertex, masks);
+        int numNeighbors = 0;
+        for (const auto &mask : masks)
+            numNeighbors += mask.weight * PackedStateSequence::countBits(mask.bits);
+        countPackedNeighborStates(m_packedPastStates, masks.data(), masks.size(), numNeighbors, first, length, neighborCounts.data());
+        return {pastStates.data(), futureStates.data(), neighborCounts.data(), 1, 2};
+    }
+
+    void Dynamics::getNeighborMasks(BaseGraph::VertexIndex vertex, std::vector<PackedVertexMask> &masks) const
+    {
+        masks.clear();
+        for (auto neighbor : DataModel::getGraph().getOutNeighbours(vertex))
         {
-            prevNeighborMap.insert({u, m_neighborsPastStateSequence[u]});
-            nextNeighborMap.insert({u, m_neighborsPastStateSequence[u]});
+            const int weight = getNeighborWeight(vertex, neighbor);
+            if (weight > 0)
+                masks.push_back({neighbor / PackedStateSequence::WORD_SIZE, uint64_t(1) << (neighbor % PackedStateSequence::WORD_SIZE), weight});
         }
-
-        VertexState vState, uState;
-        for (size_t t = 0; t < m_length; t++)
+        std::sort(masks.begin(), masks.end(), [](const PackedVertexMask &a, const PackedVertexMask &b)
+                  { return (a.weight != b.weight) ? a.weight < b.weight : a.word < b.word; });
+        size_t numMasks = 0;
+        for (const auto &mask : masks)
         {
-            uState = m_pastStateSequence[u][t];
-            vState = m_pastStateSequence[v][t];
-            nextNeighborMap[u][t][vState] += counter;
-            if (u != v)
-                nextNeighborMap[v][t][uState] += counter;
+            if (numMasks > 0 and masks[numMasks - 1].word == mask.word and masks[numMasks - 1].weight == mask.weight)
+                masks[numMasks - 1].bits |= mask.bits;
+            else
+                masks[numMasks++] = mask;
         }
-    };
+        masks.resize(numMasks);
+    }
 
-    const double Dynamics::getLogLikelihoodRatioFromGraphMove(const GraphMove &move) const
+    const SmallVector<NeighborShift, 4> Dynamics::getNeighborShifts(BaseGraph::VertexIndex vertex, const GraphMove &move, size_t first, size_t length) const
     {
-        double logLikelihoodRatio = 0;
-        std::set<size_t> verticesAffected;
-        std::map<BaseGraph::VertexIndex, VertexNeighborhoodStateSequence> prevNeighborMap, nextNeighborMap;
+        static thread_local std::vector<std::vector<VertexState>> buffers;
+        const bool inPlace = not m_packStates and getSequenceLayout() == SequenceLayout::VertexMajor;
+        SmallVector<NeighborShift, 4> shifts;
+        const auto insertShift = [&](const BaseGraph::Edge &edge, int counter)
+        {
+            BaseGraph::VertexIndex neighbor;
+            if (edge.first == edge.second)
+            {
+                // Self-loops count twice, as in computeNeighborsState.
+                if (not m_acceptSelfLoops or edge.first != vertex)
+                    return;
+                neighbor = vertex;
+                counter *= 2;
+            }
+            else if (edge.first == vertex)
+                neighbor = edge.second;
+            else if (edge.second == vertex)
+                neighbor = edge.first;
+            else
+                return;
 
+            if (inPlace)
+            {
+                shifts.push_back({m_pastStateSequence.at(neighbor, first), counter});
+                return;
+            }
+            if (buffers.size() <= shifts.size())
+                buffers.resize(shifts.size() + 1);
+            auto &states = buffers[shifts.size()];
+            states.resize(length);
+            if (m_packStates)
+                m_packedPastStates.unpack(neighbor, states.data(), first, length);
+            else
+                for (size_t t = 0; t < length; t++)
+                    states[t] = *m_pastStateSequence.at(neighbor, first + t);
+            shifts.push_back({states.data(), counter});
+        };
         for (const auto &edge : move.addedEdges)
-        {
-            size_t v = edge.first, u = edge.second;
-            verticesAffected.insert(v);
-            verticesAffected.insert(u);
-            updateNeighborsStateFromEdgeMove(edge, 1, prevNeighborMap, nextNeighborMap);
-        }
+            insertShift(edge, 1);
         for (const auto &edge : move.removedEdges)
+            insertShift(edge, -1);
+        return shifts;
+    }
+
+    const double Dynamics::computeVertexLogLikelihood(BaseGraph::VertexIndex vertex, const GraphMove &move, size_t first, size_t length) const
+    {
+        // Scratch neighbour counts, reused by every call of the thread.
+        static thread_local VertexNeighborhoodState neighborsState;
+        neighborsState.resize(m_numStates);
+        const auto sequences = getVertexSequences(vertex, first, length);
+        const auto shifts = getNeighborShifts(vertex, move, first, length);
+
+        // Same summation order as sumLogTransitions, so that both agree bit for bit.
+        double lanes[4] = {0, 0, 0, 0}, tail[3];
+        const size_t laneLength = length - length % 4;
+        for (size_t t = 0; t < length; t++)
         {
-            size_t v = edge.first, u = edge.second;
-            verticesAffected.insert(v);
-            verticesAffected.insert(u);
-            updateNeighborsStateFromEdgeMove(edge, -1, prevNeighborMap, nextNeighborMap);
+            const VertexState *counts = sequences.neighborCounts + t * sequences.countStride;
+            std::copy(counts, counts + m_numStates, neighborsState.begin());
+            for (const auto &shift : shifts)
+                neighborsState[shift.states[t]] += shift.counter;
+            const double logTransitionProb = getLogTransitionProb(sequences.pastStates[t * sequences.stride], sequences.futureStates[t * sequences.stride], neighborsState);
+            if (t < laneLength)
+                lanes[t % 4] += logTransitionProb;
+            else
+                tail[t - laneLength] = logTransitionProb;
         }
+        double logLikelihood = (lanes[0] + lanes[2]) + (lanes[1] + lanes[3]);
+        for (size_t t = laneLength; t < length; t++)
+            logLikelihood += tail[t - laneLength];
+        return logLikelihood;
+    }
+
+    const double Dynamics::getLogLikelihoodRatioFromGraphMove(const GraphMove &move) const
+    {
+        checkGraphMove(move);
+        double logLikelihoodRatio = 0;
+        for (const auto &vertex : getVerticesAffectedByGraphMove(move))
+            logLikelihoodRatio += computeVertexLogLikelihood(vertex, move) - getVertexLogLikelihood(vertex);
+        return logLikelihoodRatio;
+    }
+
+    void Dynamics::computeLogLikelihoodCache()
+    {
+        const size_t N = DataModel::getSize();
+        m_vertexLogLikelihoods.clear();
+        m_vertexLogLikelihoodGenerations.clear();
+        m_logLikelihood = 0;
+        if (not m_cacheLogLikelihood or not hasStateSequences())
+            return;
+        m_vertexLogLikelihoods.resize(N);
+        m_vertexLogLikelihoodGenerations.assign(N, m_logLikelihoodGeneration);
+        m_logLikelihood = parallelSum(m_threadPool.get(), N, VERTEX_BLOCK_SIZE, [&](size_t vertex)
+                                      { return m_vertexLogLikelihoods[vertex] = computeVertexLogLikelihood(vertex); });
+    }
 
-        for (const auto &idx : verticesAffected)
+    void Dynamics::updateLogLikelihoodCacheFromTransitionCounts()
+    {
+        if (not isLogLikelihoodCached())
+            return;
+        m_logLikelihood = getLogLikelihoodFromTransitionCounts();
+        m_logLikelihoodGeneration++;
+    }
+
+    const TransitionCounts Dynamics::computeTransitionCounts() const
+    {
+        const size_t N = DataModel::getSize();
+        TransitionCounts transitionCounts;
+        if (not m_cacheLogLikelihood or not hasStateSequences())
+            return transitionCounts;
+        // Larger blocks, since each one fills a map of its own.
+        const size_t blockSize = 16 * VERTEX_BLOCK_SIZE;
+        std::vector<TransitionCounts> blockCounts((N + blockSize - 1) / blockSize);
+        parallelForBlocks(m_threadPool.get(), N, blockSize, [&](size_t begin, size_t end)
+                          {
+                              for (BaseGraph::VertexIndex vertex = begin; vertex < end; vertex++)
+                                  updateTransitionCounts(vertex, 1, blockCounts[begin / blockSize]); });
+        for (const auto &counts : blockCounts)
+            for (const auto &transition : counts)
+                transitionCounts[transition.first] += transition.second;
+        return transitionCounts;
+    }
+
+    void Dynamics::updateTransitionCounts(BaseGraph::VertexIndex vertex, int counter, TransitionCounts &transitionCounts, const GraphMove &move, size_t first, size_t length) const
+    {
+        // Runs of identical transitions, common in quiescent series, touch the map once.
+        static thread_local VertexNeighborhoodState key, cell;
+        key.resize(m_numStates + 2);
+        cell.resize(m_numStates + 2);
+        const auto sequences = getVertexSequences(vertex, first, length);
+        const auto shifts = getNeighborShifts(vertex, move, first, length);
+        size_t runLength = 0;
+        const auto flushRun = [&]()
         {
-            if (prevNeighborMap.count(idx) == 0 or nextNeighborMap.count(idx) == 0)
-                continue;
-            for (size_t t = 0; t < m_length; t++)
+            if (runLength == 0)
+                return;
+            if (counter > 0)
             {
-                logLikelihoodRatio += log(
-                    getTransitionProb(m_pastStateSequence[idx][t], m_futureStateSequence[idx][t], nextNeighborMap[idx][t]));
-                logLikelihoodRatio -= log(
-                    getTransitionProb(m_pastStateSequence[idx][t], m_futureStateSequence[idx][t], prevNeighborMap[idx][t]));
+                transitionCounts[key] += runLength;
+                return;
             }
+            auto it = transitionCounts.find(key);
+            if (it == transitionCounts.end() or it->second < runLength)
+                throw std::logic_error("Dynamics: cannot remove a transition of vertex " + std::to_string(vertex) + " absent from the transition counts.");
+            if ((it->second -= runLength) == 0)
+                transitionCounts.erase(it);
+        };
+        for (size_t t = 0; t < length; t++)
+        {
+            const VertexState *counts = sequences.neighborCounts + t * sequences.countStride;
+            cell[0] = sequences.pastStates[t * sequences.stride];
+            cell[1] = sequences.futureStates[t * sequences.stride];
+            std::copy(counts, counts + m_numStates, cell.begin() + 2);
+            for (const auto &shift : shifts)
+                cell[2 + shift.states[t]] += shift.counter;
+            if (runLength > 0 and cell == key)
+            {
+                runLength++;
+                continue;
+            }
+            flushRun();
+            key.swap(cell);
+            runLength = 1;
         }
+        flushRun();
+    }
 
+    const double Dynamics::getLogLikelihoodFromTransitionCounts() const
+    {
+        static thread_local VertexNeighborhoodState neighborsState;
+        neighborsState.resize(m_numStates);
+        double logLikelihood = 0;
+        for (const auto &transition : m_transitionCounts)
+        {
+            const auto &key = transition.first;
+            std::copy(key.begin() + 2, key.end(), neighborsState.begin());
+            logLikelihood += transition.second * log(getTransitionProb(key[0], key[1], neighborsState));
+        }
+        return logLikelihood;
+    }
+
+    const double Dynamics::getLogLikelihoodRatioFromParaMove(const ParamMove &move)
+    {
+        if (not isLogLikelihoodCached())
+            return DataModel::getLogLikelihoodRatioFromParaMove(move);
+        // The counts do not depend on the parameters, so the cache is left
+        // as is while the move is tried.
+        ParamMove reverseMove = {move.key, -move.value};
+        m_holdLogLikelihoodCache = true;
+        double logLikelihoodRatio = -getLogLikelihoodFromTransitionCounts();
+        applyParamMove(move);
+        logLikelihoodRatio += getLogLikelihoodFromTransitionCounts();
+        applyParamMove(reverseMove);
+        m_holdLogLikelihoodCache = false;
         return logLikelihoodRatio;
     }
 
+    void Dynamics::applyEdgeMoveToNeighborsPastStates(const BaseGraph::Edge &edge, int counter)
+    {
+        const BaseGraph::VertexIndex v = edge.first, u = edge.second;
+        const size_t stateStride = m_pastStateSequence.getTimeStride();
+        const size_t neighborsStride = m_neighborsPastStateSequence.getTimeStride();
+        const auto &pastStates = m_pastStateSequence;
+        const VertexState *uStates = pastStates.at(u, 0), *vStates = pastStates.at(v, 0);
+        VertexState *uNeighbors = m_neighborsPastStateSequence.at(u, 0), *vNeighbors = m_neighborsPastStateSequence.at(v, 0);
+        for (size_t t = 0; t < m_length; t++)
+        {
+            uNeighbors[t * neighborsStride + vStates[t * stateStride]] += counter;
+            vNeighbors[t * neighborsStride + uStates[t * stateStride]] += counter;
+        }
+    }
+
     void Dynamics::applyGraphMoveToSelf(const GraphMove &move)
     {
-        std::set<BaseGraph::VertexIndex> verticesAffected;
-        std::map<BaseGraph::VertexIndex, VertexNeighborhoodStateSequence> prevNeighborMap, nextNeighborMap;
-        VertexNeighborhoodStateSequence neighborsState(m_length);
         size_t v, u;
+        checkGraphMove(move);
+        // The cache is updated first, since counts that are not stored follow the graph, which only changes afterwards.
+        if (isLogLikelihoodCached())
+            for (const auto &vertex : getVerticesAffectedByGraphMove(move))
+            {
+                updateTransitionCounts(vertex, -1, m_transitionCounts);
+                updateTransitionCounts(vertex, 1, m_transitionCounts, move);
+                double logLikelihood = computeVertexLogLikelihood(vertex, move);
+                m_logLikelihood += logLikelihood - getVertexLogLikelihood(vertex);
+                m_vertexLogLikelihoods[vertex] = logLikelihood;
+                m_vertexLogLikelihoodGenerations[vertex] = m_logLikelihoodGeneration;
+            }
 
         for (const auto &edge : move.addedEdges)
         {
@@ -344,9 +1076,8 @@ namespace GraphInf
             u = edge.second;
             if (u == v and not m_acceptSelfLoops)
                 continue;
-            verticesAffected.insert(v);
-            verticesAffected.insert(u);
-            updateNeighborsStateFromEdgeMove(edge, 1, prevNeighborMap, nextNeighborMap);
+            if (storesNeighborsPastStates())
+                applyEdgeMoveToNeighborsPastStates(edge, 1);
             m_neighborsState[u][m_state[v]] += 1;
             m_neighborsState[v][m_state[u]] += 1;
         }
@@ -356,34 +1087,27 @@ namespace GraphInf
             u = edge.second;
             if (u == v and not m_acceptSelfLoops)
                 continue;
-            verticesAffected.insert(v);
-            verticesAffected.insert(u);
-            updateNeighborsStateFromEdgeMove(edge, -1, prevNeighborMap, nextNeighborMap);
+            if (storesNeighborsPastStates())
+                applyEdgeMoveToNeighborsPastStates(edge, -1);
             m_neighborsState[u][m_state[v]] -= 1;
             m_neighborsState[v][m_state[u]] -= 1;
         }
-
-        for (const auto &idx : verticesAffected)
-        {
-            for (size_t t = 0; t < m_length; t++)
-            {
-                m_neighborsPastStateSequence[idx][t] = nextNeighborMap[idx][t];
-            }
-        }
     }
 
     void Dynamics::checkConsistencyOfNeighborsPastStateSequence() const
     {
         const auto N = DataModel::getSize();
-        if (m_neighborsPastStateSequence.size() == 0)
+        if (not storesNeighborsPastStates() or m_neighborsPastStateSequence.size() == 0)
             return;
         else if (m_neighborsPastStateSequence.size() != N)
             throw ConsistencyError(
                 "Dynamics",
                 "graph prior", "size=" + std::to_string(N),
                 "m_neighborsPastStateSequence", "size=" + std::to_string(m_neighborsPastStateSequence.size()));
-        const auto &actual = m_neighborsPastStateSequence;
-        const auto expected = computeNeighborsStateSequence(m_pastStateSequence);
+        const CellSequenceView<VertexState> actual(m_neighborsPastStateSequence);
+        SequenceArena<VertexState> expectedSequence(m_numStates);
+        computeNeighborsStateSequence(m_pastStateSequence, m_length, expectedSequence);
+        const CellSequenceView<VertexState> expected(expectedSequence);
         for (size_t v = 0; v < N; ++v)
         {
             if (actual[v].size() != getLength())
@@ -448,10 +1172,47 @@ namespace GraphInf
         }
     }
 
+    void Dynamics::checkConsistencyOfLogLikelihoodCache() const
+    {
+        if (not isLogLikelihoodCached())
+            return;
+        double expectedTotal = 0;
+        for (size_t v = 0; v < m_vertexLogLikelihoods.size(); ++v)
+        {
+            double expected = computeVertexLogLikelihood(v);
+            expectedTotal += expected;
+            if (not isVertexLogLikelihoodStale(v) and std::abs(expected - m_vertexLogLikelihoods[v]) > 1e-6)
+                throw ConsistencyError(
+                    "Dynamics",
+                    "log-likelihood", "value=" + std::to_string(expected),
+                    "m_vertexLogLikelihoods", "value=" + std::to_string(m_vertexLogLikelihoods[v]),
+                    "vertex=" + std::to_string(v));
+        }
+        if (std::abs(expectedTotal - m_logLikelihood) > 1e-6 * std::max(1., std::abs(expectedTotal)))
+            throw ConsistencyError(
+                "Dynamics",
+                "log-likelihood", "value=" + std::to_string(expectedTotal),
+                "m_logLikelihood", "value=" + std::to_string(m_logLikelihood));
+    }
+
+    void Dynamics::checkConsistencyOfTransitionCounts() const
+    {
+        if (not isLogLikelihoodCached())
+            return;
+        const auto expected = computeTransitionCounts();
+        if (expected != m_transitionCounts)
+            throw ConsistencyError(
+                "Dynamics",
+                "transition counts", "size=" + std::to_string(expected.size()),
+                "m_transitionCounts", "size=" + std::to_string(m_transitionCounts.size()));
+    }
+
     void Dynamics::checkSelfConsistency() const
     {
         checkConsistencyOfNeighborsPastStateSequence();
         checkConsistencyOfNeighborsState();
+        checkConsistencyOfLogLikelihoodCache();
+        checkConsistencyOfTransitionCounts();
     }
 
     void Dynamics::checkSelfSafety() const
@@ -460,11 +1221,19 @@ namespace GraphInf
 
         if (m_state.size() == 0)
             throw SafetyError("Dynamics", "m_state.size()", "0");
+        if (m_packStates)
+        {
+            if (m_packedPastStates.size() == 0)
+                throw SafetyError("Dynamics", "m_packedPastStates.size()", "0");
+            if (not m_isTrajectory and m_packedFutureStates.size() == 0)
+                throw SafetyError("Dynamics", "m_packedFutureStates.size()", "0");
+            return;
+        }
         if (m_pastStateSequence.size() == 0)
             throw SafetyError("Dynamics", "m_pastStateSequence.size()", "0");
-        if (m_futureStateSequence.size() == 0)
+        if (not m_isTrajectory and m_futureStateSequence.size() == 0)
             throw SafetyError("Dynamics", "m_futureStateSequence.size()", "0");
-        if (m_neighborsPastStateSequence.size() == 0)
+        if (storesNeighborsPastStates() and m_neighborsPastStateSequence.size() == 0)
             throw SafetyError("Dynamics", "m_neighborsPastStateSequence.size()", "0");
     }
 }
\ No newline at end of file
@@ -0,0 +1,261 @@
+#include <algorithm>
+
+#include "GraphInf/data/dynamics/log_transition_kernels.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define GRAPH_INF_X86_KERNELS 1
+#include <immintrin.h>
+#else
+#define GRAPH_INF_X86_KERNELS 0
+#endif
+
+namespace GraphInf
+{
+
+    /* Every kernel adds the term of time step t to lane t % 4 for the first
+     * 4 * (length / 4) steps, and the caller adds the lanes and then the
+     * remaining steps in a fixed order. */
+    static const size_t NUM_LANES = 4;
+
+    static inline bool getTransitionIndex(
+        const LogTransitionTable &table,
+        const VertexState *pastStates,
+        const VertexState *futureStates,
+        const VertexState *neighborCounts,
+        const NeighborShift *shifts,
+        size_t numShifts,
+        size_t t,
+        int &index)
+    {
+        int inactive = neighborCounts[2 * t], active = neighborCounts[2 * t + 1];
+        for (size_t i = 0; i < numShifts; i++)
+        {
+            const int shift = shifts[i].counter * shifts[i].states[t];
+            active += shift;
+            inactive += shifts[i].counter - shift;
+        }
+        if (inactive < 0 or active < 0 or inactive >= table.inactiveSize or active >= table.activeSize)
+            return false;
+        index = 4 * (inactive * table.inactiveStride + active) + 2 * pastStates[t] + futureStates[t];
+        return true;
+    }
+
+    static bool sumLogTransitionLanesScalar(
+        const LogTransitionTable &table,
+        const VertexState *pastStates,
+        const VertexState *futureStates,
+        const VertexState *neighborCounts,
+        const NeighborShift *shifts,
+        size_t numShifts,
+        size_t length,
+        double *lanes)
+    {
+        int index;
+        for (size_t t = 0; t < length; t++)
+        {
+            if (not getTransitionIndex(table, pastStates, futureStates, neighborCounts, shifts, numShifts, t, index))
+                return false;
+            lanes[t % NUM_LANES] += table.values[index];
+        }
+        return true;
+    }
+
+#if GRAPH_INF_X86_KERNELS
+
+    __attribute__((target("sse4.1"))) static inline __m128i getTransitionIndices(
+        const LogTransitionTable &table,
+        const VertexState *pastStates,
+        const VertexState *futureStates,
+        __m128i inactive,
+        __m128i active,
+        const NeighborShift *shifts,
+        size_t numShifts,
+        size_t t,
+        bool &valid)
+    {
+        for (size_t i = 0; i < numShifts; i++)
+        {
+            const __m128i counter = _mm_set1_epi32(shifts[i].counter);
+            const __m128i shift = _mm_mullo_epi32(counter, _mm_loadu_si128((const __m128i *)(shifts[i].states + t)));
+            active = _mm_add_epi32(active, shift);
+            inactive = _mm_add_epi32(inactive, _mm_sub_epi32(counter, shift));
+        }
+        const __m128i minusOne = _mm_set1_epi32(-1);
+        const __m128i inRange = _mm_and_si128(
+            _mm_and_si128(_mm_cmpgt_epi32(inactive, minusOne), _mm_cmpgt_epi32(_mm_set1_epi32(table.inactiveSize), inactive)),
+            _mm_and_si128(_mm_cmpgt_epi32(active, minusOne), _mm_cmpgt_epi32(_mm_set1_epi32(table.activeSize), active)));
+        valid = _mm_movemask_epi8(inRange) == 0xFFFF;
+
+        const __m128i cell = _mm_add_epi32(_mm_mullo_epi32(inactive, _mm_set1_epi32(table.inactiveStride)), active);
+        const __m128i transition = _mm_add_epi32(
+            _mm_slli_epi32(_mm_loadu_si128((const __m128i *)(pastStates + t)), 1),
+            _mm_loadu_si128((const __m128i *)(futureStates + t)));
+        return _mm_add_epi32(_mm_slli_epi32(cell, 2), transition);
+    }
+
+    __attribute__((target("sse4.1"))) static bool sumLogTransitionLanesSSE4(
+        const LogTransitionTable &table,
+        const VertexState *pastStates,
+        const VertexState *futureStates,
+        const VertexState *neighborCounts,
+        const NeighborShift *shifts,
+        size_t numShifts,
+        size_t length,
+        double *lanes)
+    {
+        __m128d lowLanes = _mm_setzero_pd(), highLanes = _mm_setzero_pd();
+        alignas(16) int indices[NUM_LANES];
+        bool valid;
+        for (size_t t = 0; t < length; t += NUM_LANES)
+        {
+            // (i0, a0, i1, a1), (i2, a2, i3, a3) -> (i0, i1, i2, i3), (a0, a1, a2, a3)
+            const __m128i low = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)(neighborCounts + 2 * t)), _MM_SHUFFLE(3, 1, 2, 0));
+            const __m128i high = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)(neighborCounts + 2 * t + 4)), _MM_SHUFFLE(3, 1, 2, 0));
+            const __m128i index = getTransitionIndices(
+                table, pastStates, futureStates, _mm_unpacklo_epi64(low, high), _mm_unpackhi_epi64(low, high), shifts, numShifts, t, valid);
+            if (not valid)
+                return false;
+            _mm_store_si128((__m128i *)indices, index);
+            lowLanes = _mm_add_pd(lowLanes, _mm_set_pd(table.values[indices[1]], table.values[indices[0]]));
+            highLanes = _mm_add_pd(highLanes, _mm_set_pd(table.values[indices[3]], table.values[indices[2]]));
+        }
+        _mm_storeu_pd(lanes, lowLanes);
+        _mm_storeu_pd(lanes + 2, highLanes);
+        return true;
+    }
+
+    __attribute__((target("avx2"))) static bool sumLogTransitionLanesAVX2(
+        const LogTransitionTable &table,
+        const VertexState *pastStates,
+        const VertexState *futureStates,
+        const VertexState *neighborCounts,
+        const NeighborShift *shifts,
+        size_t numShifts,
+        size_t length,
+        double *lanes)
+    {
+        const __m256i deinterleave = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+        __m256d sums = _mm256_setzero_pd();
+        bool valid;
+        for (size_t t = 0; t < length; t += NUM_LANES)
+        {
+            const __m256i counts = _mm256_permutevar8x32_epi32(
+                _mm256_loadu_si256((const __m256i *)(neighborCounts + 2 * t)), deinterleave);
+            const __m128i index = getTransitionIndices(
+                table, pastStates, futureStates, _mm256_castsi256_si128(counts), _mm256_extracti128_si256(counts, 1), shifts, numShifts, t, valid);
+            if (not valid)
+                return false;
+            sums = _mm256_add_pd(sums, _mm256_i32gather_pd(table.values, index, 8));
+        }
+        _mm256_storeu_pd(lanes, sums);
+        return true;
+    }
+
+#endif
+
+    static void countPackedNeighborStatesScalar(
+        const PackedStateSequence &packedStates, const PackedVertexMask *masks, size_t numMasks, int numNeighbors, size_t first, size_t length, VertexState *neighborCounts)
+    {
+        for (size_t t = 0; t < length; t++)
+        {
+            const int active = packedStates.countActive(masks, numMasks, first + t);
+            neighborCounts[2 * t] = numNeighbors - active;
+            neighborCounts[2 * t + 1] = active;
+        }
+    }
+
+#if GRAPH_INF_X86_KERNELS
+
+    __attribute__((target("popcnt"))) static void countPackedNeighborStatesPopcnt(
+        const PackedStateSequence &packedStates, const PackedVertexMask *masks, size_t numMasks, int numNeighbors, size_t first, size_t length, VertexState *neighborCounts)
+    {
+        const uint64_t *words = packedStates.data() + first * packedStates.getNumWords();
+        const size_t numWords = packedStates.getNumWords();
+        for (size_t t = 0; t < length; t++, words += numWords)
+        {
+            int active = 0;
+            for (size_t i = 0; i < numMasks; i++)
+                active += masks[i].weight * (int)_mm_popcnt_u64(words[masks[i].word] & masks[i].bits);
+            neighborCounts[2 * t] = numNeighbors - active;
+            neighborCounts[2 * t + 1] = active;
+        }
+    }
+
+#endif
+
+    void countPackedNeighborStates(
+        const PackedStateSequence &packedStates, const PackedVertexMask *masks, size_t numMasks, int numNeighbors, size_t first, size_t length, VertexState *neighborCounts)
+    {
+#if GRAPH_INF_X86_KERNELS
+        static const bool hasPopcnt = []()
+        {
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("popcnt");
+        }();
+        if (hasPopcnt)
+            return countPackedNeighborStatesPopcnt(packedStates, masks, numMasks, numNeighbors, first, length, neighborCounts);
+#endif
+        countPackedNeighborStatesScalar(packedStates, masks, numMasks, numNeighbors, first, length, neighborCounts);
+    }
+
+    SimdLevel getSupportedSimdLevel()
+    {
+#if GRAPH_INF_X86_KERNELS
+        static const SimdLevel level = []()
+        {
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx2"))
+                return SimdLevel::AVX2;
+            if (__builtin_cpu_supports("sse4.1"))
+                return SimdLevel::SSE4;
+            return SimdLevel::Scalar;
+        }();
+        return level;
+#else
+        return SimdLevel::Scalar;
+#endif
+    }
+
+    bool sumLogTransitions(
+        const LogTransitionTable &table,
+        const VertexState *pastStates,
+        const VertexState *futureStates,
+        const VertexState *neighborCounts,
+        const NeighborShift *shifts,
+        size_t numShifts,
+        size_t length,
+        double &sum,
+        SimdLevel level)
+    {
+        level = std::min(level, getSupportedSimdLevel());
+        const size_t laneLength = length - length % NUM_LANES;
+        double lanes[NUM_LANES] = {0, 0, 0, 0};
+        bool valid;
+        switch (level)
+        {
+#if GRAPH_INF_X86_KERNELS
+        case SimdLevel::AVX2:
+            valid = sumLogTransitionLanesAVX2(table, pastStates, futureStates, neighborCounts, shifts, numShifts, laneLength, lanes);
+            break;
+        case SimdLevel::SSE4:
+            valid = sumLogTransitionLanesSSE4(table, pastStates, futureStates, neighborCounts, shifts, numShifts, laneLength, lanes);
+            break;
+#endif
+        default:
+            valid = sumLogTransitionLanesScalar(table, pastStates, futureStates, neighborCounts, shifts, numShifts, laneLength, lanes);
+        }
+        if (not valid)
+            return false;
+
+        sum = (lanes[0] + lanes[2]) + (lanes[1] + lanes[3]);
+        int index;
+        for (size_t t = laneLength; t < length; t++)
+        {
+            if (not getTransitionIndex(table, pastStates, futureStates, neighborCounts, shifts, numShifts, t, index))
+                return false;
+            sum += table.values[index];
+        }
+        return true;
+    }
+
+}
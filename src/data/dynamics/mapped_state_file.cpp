@@ -0,0 +1,152 @@
+#include <cerrno>
+#include <cstring>
+#include <cstdint>
+#include <stdexcept>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "GraphInf/data/dynamics/mapped_state_file.h"
+
+namespace GraphInf
+{
+
+    static const char NPY_MAGIC[] = "\x93NUMPY";
+    static const size_t NPY_MAGIC_SIZE = 6;
+
+    MappedStateFile::MappedStateFile(const std::string &path) : m_path(path)
+    {
+#ifdef _WIN32
+        throw std::runtime_error("MappedStateFile: memory-mapped files are not supported on this platform.");
+#else
+        const int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            throw std::runtime_error("MappedStateFile: cannot open `" + path + "`: " + std::strerror(errno) + ".");
+        struct stat status;
+        if (fstat(fd, &status) != 0)
+        {
+            close(fd);
+            throw std::runtime_error("MappedStateFile: cannot read the size of `" + path + "`.");
+        }
+        m_mappingSize = status.st_size;
+        if (m_mappingSize > 0)
+        {
+            m_address = mmap(nullptr, m_mappingSize, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (m_address == MAP_FAILED)
+            {
+                m_address = nullptr;
+                close(fd);
+                throw std::runtime_error("MappedStateFile: cannot map `" + path + "`: " + std::strerror(errno) + ".");
+            }
+        }
+        // The mapping stays valid once the descriptor is closed.
+        close(fd);
+
+        const char *bytes = static_cast<const char *>(m_address);
+        size_t dataOffset = 0;
+        if (m_mappingSize >= NPY_MAGIC_SIZE and std::memcmp(bytes, NPY_MAGIC, NPY_MAGIC_SIZE) == 0)
+        {
+            try
+            {
+                parseNpyHeader(bytes, m_mappingSize, dataOffset);
+            }
+            catch (...)
+            {
+                munmap(m_address, m_mappingSize);
+                throw;
+            }
+        }
+        else
+        {
+            if (m_mappingSize % sizeof(VertexState) != 0)
+            {
+                if (m_address)
+                    munmap(m_address, m_mappingSize);
+                throw std::runtime_error("MappedStateFile: size of `" + path + "` is not a multiple of " + std::to_string(sizeof(VertexState)) + " bytes.");
+            }
+            m_shape = {m_mappingSize / sizeof(VertexState)};
+        }
+        m_states = reinterpret_cast<const VertexState *>(bytes + dataOffset);
+#endif
+    }
+
+    MappedStateFile::~MappedStateFile()
+    {
+#ifndef _WIN32
+        if (m_address)
+            munmap(m_address, m_mappingSize);
+#endif
+    }
+
+    /* Reads the header of a `.npy` file, version 1 to 3: the magic string,
+     * the version, the header length, then a Python dict literal such as
+     * {'descr': '<i4', 'fortran_order': False, 'shape': (100, 1001), }. */
+    void MappedStateFile::parseNpyHeader(const char *bytes, size_t numBytes, size_t &dataOffset)
+    {
+        const std::string error = "MappedStateFile: `" + m_path + "` ";
+        if (numBytes < NPY_MAGIC_SIZE + 4)
+            throw std::runtime_error(error + "has a truncated .npy header.");
+        const unsigned char *header = reinterpret_cast<const unsigned char *>(bytes);
+        const unsigned char major = header[NPY_MAGIC_SIZE];
+        size_t headerLength;
+        if (major == 1)
+        {
+            headerLength = header[8] | (header[9] << 8);
+            dataOffset = 10 + headerLength;
+        }
+        else if (major == 2 or major == 3)
+        {
+            if (numBytes < 12)
+                throw std::runtime_error(error + "has a truncated .npy header.");
+            headerLength = header[8] | (header[9] << 8) | (header[10] << 16) | (size_t(header[11]) << 24);
+            dataOffset = 12 + headerLength;
+        }
+        else
+            throw std::runtime_error(error + "has an unknown .npy version " + std::to_string(major) + ".");
+        if (dataOffset > numBytes)
+            throw std::runtime_error(error + "has a truncated .npy header.");
+        const std::string dict(bytes + dataOffset - headerLength, headerLength);
+
+        const auto findValue = [&](const std::string &key)
+        {
+            const size_t keyPosition = dict.find("'" + key + "'");
+            if (keyPosition == std::string::npos)
+                throw std::runtime_error(error + "has no `" + key + "` in its .npy header.");
+            const size_t colon = dict.find(':', keyPosition);
+            return dict.find_first_not_of(' ', colon + 1);
+        };
+
+        size_t position = findValue("descr");
+        const std::string descr = dict.substr(position + 1, dict.find('\'', position + 1) - position - 1);
+        const uint16_t one = 1;
+        const char endianness = (*reinterpret_cast<const unsigned char *>(&one) == 1) ? '<' : '>';
+        if (sizeof(VertexState) != 4 or descr.size() != 3 or (descr[0] != endianness and descr[0] != '=') or descr.substr(1) != "i4")
+            throw std::runtime_error(error + "holds values of dtype `" + descr + "`, expected native int32.");
+
+        position = findValue("fortran_order");
+        if (dict.compare(position, 4, "True") == 0)
+            throw std::runtime_error(error + "is in Fortran order, expected C order.");
+
+        position = findValue("shape");
+        const size_t end = dict.find(')', position);
+        if (dict[position] != '(' or end == std::string::npos)
+            throw std::runtime_error(error + "has an invalid shape in its .npy header.");
+        m_shape.clear();
+        for (size_t i = position + 1; i < end;)
+        {
+            i = dict.find_first_of("0123456789", i);
+            if (i >= end)
+                break;
+            size_t next;
+            m_shape.push_back(std::stoull(dict.substr(i), &next));
+            i += next;
+        }
+        if ((numBytes - dataOffset) / sizeof(VertexState) < size())
+            throw std::runtime_error(error + "holds fewer values than its shape.");
+    }
+
+} // namespace GraphInf
@@ -17,10 +17,10 @@ namespace GraphInf
 
     // int generateCategorical(const std::vector<double>& probs){
     //     std::discrete_distribution<int> dist(probs.begin(), probs.end());
-    //     return dist(rng);
+    //     return dist(gen);
     // }
 
-    std::vector<size_t> sampleUniformlySequenceWithoutReplacement(size_t n, size_t k)
+    std::vector<size_t> sampleUniformlySequenceWithoutReplacement(size_t n, size_t k, RNG &gen)
     {
         std::unordered_map<size_t, size_t> indexReplacements;
         size_t newDrawnIndex;
@@ -28,7 +28,7 @@ namespace GraphInf
 
         for (size_t i = 0; i < k; i++)
         {
-            newDrawnIndex = std::uniform_int_distribution<size_t>(i, n - 1)(rng);
+            newDrawnIndex = std::uniform_int_distribution<size_t>(i, n - 1)(gen);
 
             if (indexReplacements.find(newDrawnIndex) == indexReplacements.end())
                 drawnIndices.push_back(newDrawnIndex);
@@ -43,7 +43,7 @@ namespace GraphInf
         return drawnIndices;
     }
 
-    std::list<size_t> sampleRandomComposition(size_t n, size_t k)
+    std::list<size_t> sampleRandomComposition(size_t n, size_t k, RNG &gen)
     {
         // sample the composition of n into exactly k parts
         std::list<size_t> composition;
@@ -54,7 +54,7 @@ namespace GraphInf
         }
         std::vector<size_t> uniformRandomSequence(k - 1);
 
-        uniformRandomSequence = sampleUniformlySequenceWithoutReplacement(n - 1, k - 1);
+        uniformRandomSequence = sampleUniformlySequenceWithoutReplacement(n - 1, k - 1, gen);
         std::sort(uniformRandomSequence.begin(), uniformRandomSequence.end());
 
         composition.push_back(uniformRandomSequence[0] + 1);
@@ -64,7 +64,7 @@ namespace GraphInf
         return composition;
     }
 
-    std::list<size_t> sampleRandomWeakComposition(size_t n, size_t k)
+    std::list<size_t> sampleRandomWeakComposition(size_t n, size_t k, RNG &gen)
     {
         // sample the weak composition of n into exactly k parts
         if (k == 1)
@@ -80,7 +80,7 @@ namespace GraphInf
         std::list<size_t> weakComposition;
         std::vector<size_t> uniformRandomSequence(k - 1);
 
-        uniformRandomSequence = sampleUniformlySequenceWithoutReplacement(n + k - 1, k - 1);
+        uniformRandomSequence = sampleUniformlySequenceWithoutReplacement(n + k - 1, k - 1, gen);
         std::sort(uniformRandomSequence.begin(), uniformRandomSequence.end());
 
         weakComposition.push_back(uniformRandomSequence[0]);
@@ -91,13 +91,13 @@ namespace GraphInf
         return weakComposition;
     }
 
-    std::list<size_t> sampleRandomRestrictedPartition(size_t n, size_t k, size_t numberOfSteps)
+    std::list<size_t> sampleRandomRestrictedPartition(size_t n, size_t k, size_t numberOfSteps, RNG &gen)
     {
         // sample the partition of n into exactly k parts with zeros
         if (numberOfSteps == 0)
             numberOfSteps = n;
 
-        auto partition = sampleRandomWeakComposition(n, k);
+        auto partition = sampleRandomWeakComposition(n, k, gen);
         partition.sort();
         auto skimmedPartition = partition;
         skimmedPartition.unique();
@@ -105,12 +105,12 @@ namespace GraphInf
 
         for (size_t i = 0; i < numberOfSteps; i++)
         {
-            auto newPartition = sampleRandomWeakComposition(n, k);
+            auto newPartition = sampleRandomWeakComposition(n, k, gen);
             newPartition.sort();
             auto skimmedNewPartition = newPartition;
             skimmedNewPartition.unique();
             double Q = logMultinomialCoefficient(skimmedNewPartition);
-            if (std::uniform_int_distribution<size_t>(0, 1)(rng) < exp(P - Q))
+            if (std::uniform_int_distribution<size_t>(0, 1)(gen) < exp(P - Q))
             {
                 partition = newPartition;
                 P = Q;
@@ -119,7 +119,7 @@ namespace GraphInf
         return partition;
     }
 
-    std::vector<size_t> sampleRandomPermutation(const std::vector<size_t> &nk)
+    std::vector<size_t> sampleRandomPermutation(const std::vector<size_t> &nk, RNG &gen)
     {
         // sample the permutation of a multiset of K elements with multiciplicity {nk}.
         size_t sum = 0;
@@ -136,7 +136,7 @@ namespace GraphInf
         {
             indices.push_back(i);
         }
-        std::shuffle(indices.begin(), indices.end(), rng);
+        std::shuffle(indices.begin(), indices.end(), gen);
 
         std::vector<size_t> sequence(indices.size());
         size_t idx = 0;
@@ -149,7 +149,7 @@ namespace GraphInf
         return sequence;
     }
 
-    std::vector<size_t> sampleMultinomial(const size_t n, const std::vector<double> &p)
+    std::vector<size_t> sampleMultinomial(const size_t n, const std::vector<double> &p, RNG &gen)
     {
         std::vector<size_t> output(p.size(), 0);
         std::vector<size_t> idx = argsortVector(p);
@@ -171,7 +171,7 @@ namespace GraphInf
             for (size_t j = 0; j < p.size(); ++j)
             {
                 norm += sorted[j];
-                if (dist(rng) <= norm)
+                if (dist(gen) <= norm)
                     s.insert(idx[j]);
             }
             if (s.size() != p.size())
@@ -181,21 +181,21 @@ namespace GraphInf
         }
         return output;
     }
-    std::vector<size_t> sampleUniformMultinomial(const size_t n, const size_t k)
+    std::vector<size_t> sampleUniformMultinomial(const size_t n, const size_t k, RNG &gen)
     {
         std::vector<double> p;
         for (size_t i = 0; i < k; ++i)
             p.push_back((double)1. / (double)k);
-        return sampleMultinomial(n, p);
+        return sampleMultinomial(n, p, gen);
     }
 
     BaseGraph::VertexIndex sampleRandomNeighbor(
-        const MultiGraph &graph, const BaseGraph::VertexIndex vertex, bool withMultiplicity)
+        const MultiGraph &graph, const BaseGraph::VertexIndex vertex, bool withMultiplicity, RNG &gen)
     {
         const size_t degree = (withMultiplicity) ? graph.getDegree(vertex) : graph.getOutNeighbours(vertex).size();
         std::uniform_int_distribution<size_t> dist(0, degree - 1);
         BaseGraph::VertexIndex neighborIndex;
-        int counter = dist(rng);
+        int counter = dist(gen);
 
         for (const auto &neighbor : graph.getOutNeighbours(vertex))
         {
@@ -215,7 +215,8 @@ namespace GraphInf
     BaseGraph::UndirectedMultigraph generateDCSBM(
         const BlockSequence &blockSeq,
         const MultiGraph &labelGraph,
-        const DegreeSequence &degrees)
+        const DegreeSequence &degrees,
+        RNG &gen)
     {
 
         if (degrees.size() != blockSeq.size())
@@ -246,7 +247,7 @@ namespace GraphInf
                                             "Sum of row doesn't equal the sum of nodes in block " +
                                             std::to_string(block) + ".");
 
-            std::shuffle(stubsOfBlock[block].begin(), stubsOfBlock[block].end(), rng);
+            std::shuffle(stubsOfBlock[block].begin(), stubsOfBlock[block].end(), gen);
         }
 
         MultiGraph multigraph(vertexNumber);
@@ -275,7 +276,7 @@ namespace GraphInf
         return multigraph;
     }
 
-    BaseGraph::UndirectedMultigraph generateSBM(const BlockSequence &blockSeq, const MultiGraph &labelGraph, bool withSelfLoops)
+    BaseGraph::UndirectedMultigraph generateSBM(const BlockSequence &blockSeq, const MultiGraph &labelGraph, bool withSelfLoops, RNG &gen)
     {
 
         if (*std::max_element(blockSeq.begin(), blockSeq.end()) >= labelGraph.getSize())
@@ -305,7 +306,7 @@ namespace GraphInf
 
             if (labeledEdges.second.size() < ers)
                 throw std::invalid_argument("generateSBM: edge count at r=" + std::to_string(r) + " and s=" + std::to_string(s) + " (ers=" + std::to_string(ers) + ") must be greater than the total number of pairs (" + std::to_string(labeledEdges.second.size()) + ").");
-            auto indices = sampleUniformlySequenceWithoutReplacement(labeledEdges.second.size(), ers);
+            auto indices = sampleUniformlySequenceWithoutReplacement(labeledEdges.second.size(), ers, gen);
             for (const auto &i : indices)
                 graph.addEdge(labeledEdges.second[i].first, labeledEdges.second[i].second);
         }
@@ -313,7 +314,7 @@ namespace GraphInf
         return graph;
     }
 
-    BaseGraph::UndirectedMultigraph generateStubLabeledSBM(const BlockSequence &blockSeq, const MultiGraph &labelGraph, bool withSelfLoops)
+    BaseGraph::UndirectedMultigraph generateStubLabeledSBM(const BlockSequence &blockSeq, const MultiGraph &labelGraph, bool withSelfLoops, RNG &gen)
     {
 
         if (*std::max_element(blockSeq.begin(), blockSeq.end()) >= labelGraph.getSize())
@@ -341,12 +342,12 @@ namespace GraphInf
                 {
                     if (withSelfLoops or inBlock != outBlock)
                     {
-                        vertex1 = pickElementUniformly<size_t>(verticesInBlock[outBlock]);
-                        vertex2 = pickElementUniformly<size_t>(verticesInBlock[inBlock]);
+                        vertex1 = pickElementUniformly<size_t>(verticesInBlock[outBlock], gen);
+                        vertex2 = pickElementUniformly<size_t>(verticesInBlock[inBlock], gen);
                     }
                     else
                     {
-                        auto p = sampleUniformlySequenceWithoutReplacement(verticesInBlock[inBlock].size(), 2);
+                        auto p = sampleUniformlySequenceWithoutReplacement(verticesInBlock[inBlock].size(), 2, gen);
                         vertex1 = p[0];
                         vertex2 = p[1];
                     }
@@ -357,7 +358,7 @@ namespace GraphInf
         return multigraph;
     }
 
-    BaseGraph::UndirectedMultigraph generateMultiGraphSBM(const BlockSequence &blockSeq, const MultiGraph &labelGraph, bool withSelfLoops)
+    BaseGraph::UndirectedMultigraph generateMultiGraphSBM(const BlockSequence &blockSeq, const MultiGraph &labelGraph, bool withSelfLoops, RNG &gen)
     {
 
         // displayVector(blockSeq, "[generator] b", true);
@@ -386,7 +387,7 @@ namespace GraphInf
         {
             BlockIndex r = labeledEdges.first.first, s = labeledEdges.first.second;
             size_t ers = labelGraph.getEdgeMultiplicity(r, s);
-            auto flatMultiplicity = sampleRandomWeakComposition(ers, labeledEdges.second.size());
+            auto flatMultiplicity = sampleRandomWeakComposition(ers, labeledEdges.second.size(), gen);
             size_t counter = 0;
             for (const auto &m : flatMultiplicity)
             {
@@ -399,7 +400,7 @@ namespace GraphInf
         return graph;
     }
 
-    MultiGraph generateCM(const DegreeSequence &degrees)
+    MultiGraph generateCM(const DegreeSequence &degrees, RNG &gen)
     {
         size_t n = degrees.size();
         MultiGraph randomGraph(n);
@@ -413,7 +414,7 @@ namespace GraphInf
                 stubs.insert(stubs.end(), degree, i);
         }
 
-        std::shuffle(stubs.begin(), stubs.end(), rng);
+        std::shuffle(stubs.begin(), stubs.end(), gen);
 
         size_t vertex1, vertex2;
         auto stubIterator = stubs.begin();
@@ -427,7 +428,7 @@ namespace GraphInf
         return randomGraph;
     }
 
-    MultiGraph generateErdosRenyi(size_t size, size_t edgeCount, bool withSelfLoops)
+    MultiGraph generateErdosRenyi(size_t size, size_t edgeCount, bool withSelfLoops, RNG &gen)
     {
         std::vector<BaseGraph::Edge> allEdges;
         for (size_t i = 0; i < size; ++i)
@@ -437,7 +438,7 @@ namespace GraphInf
         if (allEdges.size() < edgeCount)
             throw std::invalid_argument("generateErdosRenyi: edge count (" + std::to_string(edgeCount) +
                                         ") must be greater than the total number of pairs (with N=" + std::to_string(size) + ").");
-        auto indices = sampleUniformlySequenceWithoutReplacement(allEdges.size(), edgeCount);
+        auto indices = sampleUniformlySequenceWithoutReplacement(allEdges.size(), edgeCount, gen);
 
         MultiGraph graph(size);
         for (auto i : indices)
@@ -445,7 +446,7 @@ namespace GraphInf
         return graph;
     }
 
-    MultiGraph generateStubLabeledErdosRenyi(size_t size, size_t edgeCount, bool withSelfLoops)
+    MultiGraph generateStubLabeledErdosRenyi(size_t size, size_t edgeCount, bool withSelfLoops, RNG &gen)
     {
         MultiGraph graph(size);
         std::uniform_int_distribution<size_t> dist(0, size - 1);
@@ -454,12 +455,12 @@ namespace GraphInf
             BaseGraph::VertexIndex i, j;
             if (withSelfLoops)
             {
-                i = dist(rng);
-                j = dist(rng);
+                i = dist(gen);
+                j = dist(gen);
             }
             else
             {
-                auto edge = sampleUniformlySequenceWithoutReplacement(size, 2);
+                auto edge = sampleUniformlySequenceWithoutReplacement(size, 2, gen);
                 i = edge[0], j = edge[1];
             }
             graph.addMultiedge(i, j, 1);
@@ -467,14 +468,14 @@ namespace GraphInf
         return graph;
     }
 
-    MultiGraph generateMultiGraphErdosRenyi(size_t size, size_t edgeCount, bool withSelfLoops)
+    MultiGraph generateMultiGraphErdosRenyi(size_t size, size_t edgeCount, bool withSelfLoops, RNG &gen)
     {
         std::vector<BaseGraph::Edge> allEdges;
         for (size_t i = 0; i < size; ++i)
             for (size_t j = i; j < size; ++j)
                 if (withSelfLoops or j != i)
                     allEdges.push_back({i, j});
-        auto flatMultiplicity = sampleRandomWeakComposition(edgeCount, allEdges.size());
+        auto flatMultiplicity = sampleRandomWeakComposition(edgeCount, allEdges.size(), gen);
         MultiGraph graph(size);
         size_t counter = 0;
         for (auto m : flatMultiplicity)
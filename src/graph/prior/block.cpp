@@ -62,7 +62,7 @@ namespace GraphInf
         std::uniform_int_distribution<size_t> dist(0, getBlockCount() - 1);
         for (size_t vertex = 0; vertex < getSize(); vertex++)
         {
-            blockSeq[vertex] = dist(rng);
+            blockSeq[vertex] = dist(*m_rngPtr);
         }
 
         m_state = reducePartition(blockSeq);
@@ -90,14 +90,14 @@ namespace GraphInf
     void BlockUniformHyperPrior::sampleState()
     {
 
-        std::list<size_t> vertexCountList = sampleRandomComposition(getSize(), getBlockCount());
+        std::list<size_t> vertexCountList = sampleRandomComposition(getSize(), getBlockCount(), *m_rngPtr);
         std::vector<size_t> vertexCounts;
         for (auto nr : vertexCountList)
         {
             vertexCounts.push_back(nr);
         }
 
-        std::vector<size_t> blocks = sampleRandomPermutation(vertexCounts);
+        std::vector<size_t> blocks = sampleRandomPermutation(vertexCounts, *m_rngPtr);
         m_state.clear();
         for (auto b : blocks)
             m_state.push_back(b);
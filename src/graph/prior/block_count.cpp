@@ -17,7 +17,7 @@ namespace GraphInf
     {
         auto blockCount = 0;
         while (blockCount == 0) // zero-truncated Poisson sampling
-            blockCount = m_poissonDistribution(rng);
+            blockCount = m_poissonDistribution(*m_rngPtr);
         setState(blockCount);
     };
 
@@ -161,7 +161,7 @@ namespace GraphInf
 
     void DegreeUniformPrior::sampleState()
     {
-        auto degreeList = sampleRandomWeakComposition(2 * getEdgeCount(), getSize());
+        auto degreeList = sampleRandomWeakComposition(2 * getEdgeCount(), getSize(), *m_rngPtr);
         DegreeSequence degreeSeq;
         for (auto k : degreeList)
             degreeSeq.push_back(k);
@@ -170,9 +170,9 @@ namespace GraphInf
 
     void DegreeUniformHyperPrior::sampleState()
     {
-        auto orderedDegreeList = sampleRandomRestrictedPartition(2 * getEdgeCount(), getSize());
+        auto orderedDegreeList = sampleRandomRestrictedPartition(2 * getEdgeCount(), getSize(), 0, *m_rngPtr);
         std::vector<size_t> degreeSeq(orderedDegreeList.begin(), orderedDegreeList.end());
-        std::shuffle(std::begin(degreeSeq), std::end(degreeSeq), rng);
+        std::shuffle(std::begin(degreeSeq), std::end(degreeSeq), *m_rngPtr);
         setState(degreeSeq);
     }
 
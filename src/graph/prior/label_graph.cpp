@@ -175,7 +175,7 @@ namespace GraphInf
             }
         }
 
-        auto edgeMultiplicities = sampleRandomWeakComposition(getEdgeCount(), allEdges.size());
+        auto edgeMultiplicities = sampleRandomWeakComposition(getEdgeCount(), allEdges.size(), *m_rngPtr);
 
         size_t counter = 0;
         for (auto m : edgeMultiplicities)
@@ -270,7 +270,7 @@ namespace GraphInf
         size_t E_in, E_out;
         if (Beff > 1)
         {
-            E_in = dist(rng);
+            E_in = dist(*m_rngPtr);
             E_out = getEdgeCount() - E_in;
         }
         else
@@ -278,9 +278,9 @@ namespace GraphInf
             E_in = getEdgeCount();
             E_out = 0;
         }
-        std::vector<size_t> e_in = sampleUniformMultinomial(E_in, Beff), e_out;
+        std::vector<size_t> e_in = sampleUniformMultinomial(E_in, Beff, *m_rngPtr), e_out;
         if (Beff > 1)
-            e_out = sampleUniformMultinomial(E_out, Beff * (Beff - 1) / 2);
+            e_out = sampleUniformMultinomial(E_out, Beff * (Beff - 1) / 2, *m_rngPtr);
 
         LabelGraph labelGraph(B);
 
@@ -188,7 +188,7 @@ namespace GraphInf
         const CounterMap<BlockIndex> &vertexCounts = getBlockPrior().getVertexCounts();
         for (size_t r = 0; r < getBlockPrior().getBlockCount(); r++)
         {
-            degreeSeqInBlocks[r] = sampleRandomWeakComposition(edgeCounts[r], vertexCounts[r]);
+            degreeSeqInBlocks[r] = sampleRandomWeakComposition(edgeCounts[r], vertexCounts[r], *m_rngPtr);
             ptr_degreeSeqInBlocks[r] = degreeSeqInBlocks[r].begin();
         }
 
@@ -274,9 +274,9 @@ namespace GraphInf
         std::vector<std::list<size_t>> unorderedDegrees(B);
         for (size_t r = 0; r < B; ++r)
         {
-            auto p = sampleRandomRestrictedPartition(er[r], nr[r]);
+            auto p = sampleRandomRestrictedPartition(er[r], nr[r], 0, *m_rngPtr);
             std::vector<size_t> v(p.begin(), p.end());
-            std::shuffle(std::begin(v), std::end(v), rng);
+            std::shuffle(std::begin(v), std::end(v), *m_rngPtr);
             unorderedDegrees[r].assign(v.begin(), v.end());
         }
 
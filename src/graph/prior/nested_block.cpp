@@ -209,7 +209,7 @@ namespace GraphInf
         std::uniform_int_distribution<size_t> dist(0, B - 1);
         for (size_t vertex = 0; vertex < N; vertex++)
         {
-            blocks.push_back(dist(rng));
+            blocks.push_back(dist(*m_rngPtr));
         }
         return blocks;
     }
@@ -240,14 +240,14 @@ namespace GraphInf
 
         size_t N = getNestedBlockCount(level - 1);
         size_t B = getNestedBlockCount(level);
-        std::list<size_t> vertexCountList = sampleRandomComposition(N, B);
+        std::list<size_t> vertexCountList = sampleRandomComposition(N, B, *m_rngPtr);
         std::vector<size_t> vertexCounts;
         for (auto nr : vertexCountList)
         {
             vertexCounts.push_back(nr);
         }
         std::vector<BlockIndex> blocks;
-        for (auto b : sampleRandomPermutation(vertexCounts))
+        for (auto b : sampleRandomPermutation(vertexCounts, *m_rngPtr))
             blocks.push_back(b);
         return blocks;
     }
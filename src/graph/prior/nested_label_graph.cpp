@@ -238,7 +238,7 @@ namespace GraphInf
                 ers = getEdgeCount();
             else
                 ers = getNestedState(level + 1).getEdgeMultiplicity(r, s);
-            auto flatMultiplicity = sampleRandomWeakComposition(ers, labeledEdges.second.size());
+            auto flatMultiplicity = sampleRandomWeakComposition(ers, labeledEdges.second.size(), *m_rngPtr);
             size_t counter = 0;
             for (const auto &m : flatMultiplicity)
             {
@@ -13,7 +13,7 @@ namespace GraphInf
         m_edgeSampler.onEdgeAddition(edge1);
 
         BaseGraph::Edge newEdge1, newEdge2;
-        if (m_swapOrientationDistribution(rng))
+        if (m_swapOrientationDistribution(*m_rngPtr))
         {
             newEdge1 = {edge1.first, edge2.first};
             newEdge2 = {edge1.second, edge2.second};
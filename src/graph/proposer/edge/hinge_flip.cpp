@@ -18,7 +18,7 @@ namespace GraphInf
         ++m_vertexProposalCounter[vertex];
 
         BaseGraph::Edge newEdge;
-        if (m_flipOrientationDistribution(rng))
+        if (m_flipOrientationDistribution(*m_rngPtr))
         {
             newEdge = {edge.first, vertex};
             edge = {edge.first, edge.second};
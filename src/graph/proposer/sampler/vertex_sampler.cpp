@@ -17,11 +17,11 @@ namespace GraphInf
     BaseGraph::VertexIndex VertexDegreeSampler::sample() const
     {
         double prob = m_shift * m_vertexSampler.total_weight() / (m_shift * m_vertexSampler.total_weight() + m_totalEdgeWeight);
-        if (m_uniform01(rng) < prob)
-            return m_vertexSampler.sample_ext_RNG(rng).first;
+        if (m_uniform01(*m_rngPtr) < prob)
+            return m_vertexSampler.sample_ext_RNG(*m_rngPtr).first;
 
         auto edge = m_edgeSampler.sample();
-        if (m_vertexChoiceDistribution(rng) or not contains(edge.second))
+        if (m_vertexChoiceDistribution(*m_rngPtr) or not contains(edge.second))
             return edge.first;
         else if (contains(edge.second))
             return edge.second;
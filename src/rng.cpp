@@ -16,4 +16,21 @@ void seedWithTime(){
 }
 const size_t& getSeed() { return SEED; }
 
+RNG makeRNGStream(size_t masterSeed, size_t streamIndex){
+    RNG stream(masterSeed);
+    for (size_t i=0; i<streamIndex; i++)
+        stream.jump();
+    return stream;
+}
+
+std::vector<RNG> makeRNGStreams(size_t masterSeed, size_t streamCount){
+    std::vector<RNG> streams;
+    RNG stream(masterSeed);
+    for (size_t i=0; i<streamCount; i++){
+        streams.push_back(stream);
+        stream.jump();
+    }
+    return streams;
+}
+
 }
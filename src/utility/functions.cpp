@@ -1,4 +1,5 @@
 #include <iostream>
+#include <cmath>
 #include <math.h>
 #include <list>
 
@@ -14,9 +15,22 @@ namespace GraphInf
 
     const size_t MAX_INTEGER_THRESHOLD = 5000;
 
+    /* `lgamma` stores the sign of the result in the global `signgam`, which
+     * races when log-probabilities are evaluated on several threads; the
+     * reentrant variant returns it instead. */
+    static double logGamma(double x)
+    {
+#ifdef _WIN32
+        return std::lgamma(x);
+#else
+        int sign;
+        return lgamma_r(x, &sign);
+#endif
+    }
+
     double logFactorial(size_t n)
     {
-        return lgamma(n + 1);
+        return logGamma(n + 1);
         // if (n < MAX_INTEGER_THRESHOLD)
         //     return lgamma(n + 1);
         // else
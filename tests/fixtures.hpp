@@ -146,12 +146,6 @@ namespace GraphInf
             const VertexState &prevVertexState,
             const VertexState &nextVertexState,
             const VertexNeighborhoodState &vertexNeighborhoodState) const { return 1. / getNumStates(); }
-
-        void updateNeighborsStateFromEdgeMove(
-            BaseGraph::Edge edge,
-            int direction,
-            std::map<BaseGraph::VertexIndex, VertexNeighborhoodStateSequence> &prev,
-            std::map<BaseGraph::VertexIndex, VertexNeighborhoodStateSequence> &next) const { Dynamics::updateNeighborsStateFromEdgeMove(edge, direction, prev, next); }
     };
 
     class DummySISDynamics : public SISDynamics
@@ -0,0 +1,152 @@
+#include "gtest/gtest.h"
+#include <thread>
+#include <vector>
+
+#include "GraphInf/rng.h"
+#include "GraphInf/graph/erdosrenyi.h"
+#include "GraphInf/graph/configuration.h"
+#include "GraphInf/graph/sbm.h"
+#include "GraphInf/graph/dcsbm.h"
+#include "GraphInf/graph/hsbm.h"
+#include "GraphInf/graph/hdcsbm.h"
+#include "GraphInf/data/dynamics/sis.h"
+
+namespace GraphInf
+{
+
+    class TestConcurrentEvaluation : public ::testing::Test
+    {
+    public:
+        static const size_t THREAD_COUNT = 8, NUM_MOVES = 200, NUM_REPEATS = 5;
+
+        /* Calls `evaluate(i)` for every move index from THREAD_COUNT threads at
+         * once, each thread starting at a different index, and expects exactly
+         * the values of a serial evaluation. */
+        template <typename Evaluate>
+        static void expectSameAsSerial(size_t count, const Evaluate &evaluate)
+        {
+            std::vector<double> expected(count);
+            for (size_t i = 0; i < count; i++)
+                expected[i] = evaluate(i);
+
+            std::vector<std::vector<double>> actual(THREAD_COUNT, std::vector<double>(count));
+            std::vector<std::thread> threads;
+            for (size_t t = 0; t < THREAD_COUNT; t++)
+                threads.push_back(std::thread([&, t]()
+                                              {
+                                                  for (size_t r = 0; r < NUM_REPEATS; r++)
+                                                      for (size_t k = 0; k < count; k++)
+                                                      {
+                                                          size_t i = (k + t * count / THREAD_COUNT) % count;
+                                                          actual[t][i] = evaluate(i);
+                                                      } }));
+            for (auto &thread : threads)
+                thread.join();
+
+            for (size_t t = 0; t < THREAD_COUNT; t++)
+                for (size_t i = 0; i < count; i++)
+                    EXPECT_EQ(actual[t][i], expected[i]) << "thread " << t << ", move " << i;
+        }
+
+        static void expectGraphRatiosSameAsSerial(const RandomGraph &graph)
+        {
+            std::vector<GraphMove> moves;
+            for (size_t i = 0; i < NUM_MOVES; i++)
+                moves.push_back(graph.proposeGraphMove());
+            expectSameAsSerial(moves.size(), [&](size_t i)
+                               { return graph.getLogJointRatioFromGraphMove(moves[i]); });
+            expectSameAsSerial(moves.size(), [&](size_t i)
+                               { return graph.getLogProposalRatioFromGraphMove(moves[i]); });
+            expectSameAsSerial(1, [&](size_t)
+                               { return graph.getLogJoint(); });
+        }
+
+        static void expectLabelRatiosSameAsSerial(const VertexLabeledRandomGraph<BlockIndex> &graph)
+        {
+            std::vector<BlockMove> moves;
+            while (moves.size() < NUM_MOVES)
+            {
+                auto move = graph.proposeLabelMove();
+                if (graph.isValidLabelMove(move))
+                    moves.push_back(move);
+            }
+            expectSameAsSerial(moves.size(), [&](size_t i)
+                               { return graph.getLogJointRatioFromLabelMove(moves[i]); });
+            expectSameAsSerial(moves.size(), [&](size_t i)
+                               { return graph.getLogProposalRatioFromLabelMove(moves[i]); });
+        }
+
+        void SetUp() { seed(13); }
+    };
+
+    TEST_F(TestConcurrentEvaluation, configurationModel_givenThreads_sameRatiosAsSerial)
+    {
+        ConfigurationModelFamily graph(50, 100);
+        expectGraphRatiosSameAsSerial(graph);
+    }
+
+    TEST_F(TestConcurrentEvaluation, stochasticBlockModel_givenThreads_sameRatiosAsSerial)
+    {
+        StochasticBlockModelFamily graph(50, 100, 3);
+        expectGraphRatiosSameAsSerial(graph);
+        expectLabelRatiosSameAsSerial(graph);
+    }
+
+    TEST_F(TestConcurrentEvaluation, degreeCorrectedStochasticBlockModel_givenThreads_sameRatiosAsSerial)
+    {
+        DegreeCorrectedStochasticBlockModelFamily graph(50, 100, 3);
+        expectGraphRatiosSameAsSerial(graph);
+        expectLabelRatiosSameAsSerial(graph);
+    }
+
+    TEST_F(TestConcurrentEvaluation, nestedStochasticBlockModel_givenThreads_sameRatiosAsSerial)
+    {
+        NestedStochasticBlockModelFamily graph(50, 100);
+        expectGraphRatiosSameAsSerial(graph);
+        expectLabelRatiosSameAsSerial(graph);
+    }
+
+    TEST_F(TestConcurrentEvaluation, nestedDegreeCorrectedStochasticBlockModel_givenThreads_sameRatiosAsSerial)
+    {
+        NestedDegreeCorrectedStochasticBlockModelFamily graph(50, 100);
+        expectGraphRatiosSameAsSerial(graph);
+        expectLabelRatiosSameAsSerial(graph);
+    }
+
+    TEST_F(TestConcurrentEvaluation, dynamics_givenThreads_sameRatiosAsSerial)
+    {
+        ErdosRenyiModel prior(50, 100);
+        SISDynamics dynamics(prior, 20, 0.5, 0.3);
+        dynamics.sample();
+        std::vector<GraphMove> moves;
+        for (size_t i = 0; i < NUM_MOVES; i++)
+            moves.push_back(prior.proposeGraphMove());
+        expectSameAsSerial(moves.size(), [&](size_t i)
+                           { return dynamics.getLogJointRatioFromGraphMove(moves[i]); });
+        expectSameAsSerial(moves.size(), [&](size_t i)
+                           { return dynamics.getLogAcceptanceProbFromGraphMove(moves[i]); });
+        expectSameAsSerial(1, [&](size_t)
+                           { return dynamics.getLogJoint(); });
+    }
+
+    TEST_F(TestConcurrentEvaluation, dynamics_givenParamMoveBeforeThreads_sameRatiosAsFreshCache)
+    {
+        ErdosRenyiModel prior(50, 150);
+        SISDynamics dynamics(prior, 20, 0.5, 0.3);
+        dynamics.sample();
+        std::vector<GraphMove> moves;
+        for (size_t i = 0; i < 64; i++)
+            moves.push_back(prior.proposeGraphMove());
+
+        // Every vertex is stale when the threads start.
+        dynamics.applyParamMove({"infection", 0.01});
+        dynamics.setThreadCount(4);
+        const auto actual = dynamics.getLogJointRatiosFromGraphMoves(moves);
+
+        dynamics.setThreadCount(1);
+        dynamics.setLogLikelihoodCaching(true);
+        for (size_t i = 0; i < moves.size(); i++)
+            EXPECT_DOUBLE_EQ(actual[i], dynamics.getLogJointRatioFromGraphMove(moves[i])) << "move " << i;
+    }
+
+}
@@ -0,0 +1,134 @@
+#include "gtest/gtest.h"
+#include <cmath>
+#include <vector>
+
+#include "GraphInf/data/dynamics/sis.h"
+#include "GraphInf/graph/erdosrenyi.h"
+#include "GraphInf/rng.h"
+
+namespace GraphInf
+{
+
+    class TestSpeculativeGraphSweep : public ::testing::Test
+    {
+    public:
+        const size_t NUM_STEPS = 200, WIDTH = 8;
+        ErdosRenyiModel prior = ErdosRenyiModel(20, 30);
+        SISDynamics dynamics = SISDynamics(prior, 20, 0.5, 0.3);
+        void SetUp()
+        {
+            seed(3);
+            dynamics.sample();
+            dynamics.setSpeculationWidth(WIDTH);
+        }
+
+        // Mean multiplicity of every vertex pair of `model`'s graph along a chain.
+        static std::vector<double> getMeanMultiplicities(DataModel &model, size_t numSweeps, size_t numStepsPerSweep)
+        {
+            const size_t n = model.getSize();
+            std::vector<double> means(n * n, 0);
+            for (size_t s = 0; s < numSweeps; s++)
+            {
+                model.metropolisGraphSweep(numStepsPerSweep);
+                for (size_t i = 0; i < n; i++)
+                    for (size_t j = 0; j < n; j++)
+                        means[i * n + j] += (double)model.getGraph().getEdgeMultiplicity(i, j) / numSweeps;
+            }
+            return means;
+        }
+    };
+
+    TEST_F(TestSpeculativeGraphSweep, metropolisGraphSweep_givenWidth_performEveryStep)
+    {
+        dynamics.setThreadCount(4);
+        double logJointBefore = dynamics.getLogJoint();
+        auto summary = dynamics.metropolisGraphSweep(NUM_STEPS);
+
+        // One graph step and one prior step per step.
+        EXPECT_EQ(summary.getTotalCount(), 2 * NUM_STEPS);
+        EXPECT_GT(summary.getAcceptedCount(), 0);
+        EXPECT_NEAR(dynamics.getLogJoint() - logJointBefore, summary.logJointRatio, 1e-6);
+        dynamics.checkConsistency();
+    }
+
+    TEST_F(TestSpeculativeGraphSweep, metropolisGraphSweep_givenSameSeed_resultIndependentOfThreadCount)
+    {
+        ErdosRenyiModel otherPrior(20, 30);
+        SISDynamics other(otherPrior, 20, 0.5, 0.3);
+        other.setGraph(dynamics.getGraph());
+        other.setState(dynamics.getPastStates(), dynamics.getFutureStates());
+        other.setSpeculationWidth(WIDTH);
+
+        RNG first(11), second(11);
+        dynamics.setRNG(first);
+        other.setRNG(second);
+        dynamics.setThreadCount(1);
+        other.setThreadCount(4);
+        dynamics.metropolisGraphSweep(NUM_STEPS);
+        other.metropolisGraphSweep(NUM_STEPS);
+        EXPECT_EQ(dynamics.getGraph(), other.getGraph());
+    }
+
+    TEST(TestSpeculativeGraphSweepDistribution, metropolisGraphSweep_givenWidth_sameStationaryDistribution)
+    {
+        seed(5);
+        ErdosRenyiModel prior(4, 3), otherPrior(4, 3);
+        SISDynamics sequential(prior, 10, 0.5, 0.3), speculative(otherPrior, 10, 0.5, 0.3);
+        sequential.sample();
+        speculative.setGraph(sequential.getGraph());
+        speculative.setState(sequential.getPastStates(), sequential.getFutureStates());
+        speculative.setSpeculationWidth(4);
+        speculative.setThreadCount(2);
+
+        auto expected = TestSpeculativeGraphSweep::getMeanMultiplicities(sequential, 20000, 10);
+        auto actual = TestSpeculativeGraphSweep::getMeanMultiplicities(speculative, 20000, 10);
+        for (size_t k = 0; k < expected.size(); k++)
+            EXPECT_NEAR(actual[k], expected[k], 0.05);
+    }
+
+    class TestGreedyGraphStep : public ::testing::Test
+    {
+    public:
+        const size_t NUM_STEPS = 10, NUM_CANDIDATES = 50;
+        ErdosRenyiModel prior = ErdosRenyiModel(20, 30);
+        SISDynamics dynamics = SISDynamics(prior, 20, 0.5, 0.3);
+        void SetUp()
+        {
+            seed(3);
+            dynamics.sample();
+        }
+    };
+
+    TEST_F(TestGreedyGraphStep, getLogJointRatiosFromGraphMoves_givenThreads_returnSameAsOneByOne)
+    {
+        std::vector<GraphMove> moves;
+        for (size_t i = 0; i < NUM_CANDIDATES; i++)
+            moves.push_back(prior.proposeGraphMove());
+        dynamics.setThreadCount(4);
+        auto logJointRatios = dynamics.getLogJointRatiosFromGraphMoves(moves);
+        for (size_t i = 0; i < moves.size(); i++)
+            EXPECT_EQ(logJointRatios[i], dynamics.getLogJointRatioFromGraphMove(moves[i]));
+    }
+
+    TEST_F(TestGreedyGraphStep, greedyGraphSweep_givenSameSeed_resultIndependentOfThreadCount)
+    {
+        ErdosRenyiModel otherPrior(20, 30);
+        SISDynamics other(otherPrior, 20, 0.5, 0.3);
+        other.setGraph(dynamics.getGraph());
+        other.setState(dynamics.getPastStates(), dynamics.getFutureStates());
+
+        RNG first(11), second(11);
+        dynamics.setRNG(first);
+        other.setRNG(second);
+        dynamics.setThreadCount(1);
+        other.setThreadCount(4);
+        EXPECT_EQ(other.getGraphPrior().getThreadCount(), 4);
+        double logJointBefore = dynamics.getLogJoint();
+        auto summary = dynamics.greedyGraphSweep(NUM_STEPS, NUM_CANDIDATES);
+        other.greedyGraphSweep(NUM_STEPS, NUM_CANDIDATES);
+        EXPECT_EQ(dynamics.getGraph(), other.getGraph());
+        EXPECT_GE(dynamics.getLogJoint(), logJointBefore);
+        EXPECT_NEAR(dynamics.getLogJoint() - logJointBefore, summary.logJointRatio, 1e-6);
+    }
+
+}
@@ -195,50 +195,36 @@ namespace GraphInf
         EXPECT_EQ(dynamics.getNeighborsState(), dynamics.computeNeighborsState(dynamics.getState()));
     }
 
-    TEST_P(DynamicsParametrizedTest, updateNeighborsStateFromEdgeMove_fromAddedEdge_expectCorrectionInNeighborState)
+    TEST_P(DynamicsParametrizedTest, setNeighborsPastStateCaching_withoutStoredCounts_sameTransitionCounts)
     {
+        expectConsistencyError = false;
         dynamics.sampleState();
-        BaseGraph::Edge edge = GRAPH_MOVE.addedEdges[0];
-        map<BaseGraph::VertexIndex, VertexNeighborhoodStateSequence> actualBefore, actualAfter;
-
-        dynamics.updateNeighborsStateFromEdgeMove(edge, 1, actualBefore, actualAfter);
-
-        auto expectedBefore = dynamics.getNeighborsPastStates();
-        dynamics.applyGraphMove({{}, {edge}});
-        auto expectedAfter = dynamics.getNeighborsPastStates();
-
-        for (auto actual : actualBefore)
-            for (size_t t = 0; t < dynamics.getLength(); ++t)
-                for (size_t s = 0; s < dynamics.getNumStates(); ++s)
-                    EXPECT_EQ(expectedBefore[actual.first][t][s], actual.second[t][s]);
-
-        for (auto actual : actualAfter)
-            for (size_t t = 0; t < dynamics.getLength(); ++t)
-                for (size_t s = 0; s < dynamics.getNumStates(); ++s)
-                    EXPECT_EQ(expectedAfter[actual.first][t][s], actual.second[t][s]);
+        dynamics.setNeighborsPastStateCaching(false);
+        EXPECT_EQ(dynamics.getNeighborsPastStates().size(), 0);
+        dynamics.checkConsistency();
+        dynamics.applyGraphMove(GRAPH_MOVE);
+        const TransitionCounts counts = dynamics.getTransitionCounts();
+        dynamics.setNeighborsPastStateCaching(true);
+        dynamics.setLogLikelihoodCaching(true);
+        EXPECT_EQ(counts, dynamics.getTransitionCounts());
     }
 
-    TEST_P(DynamicsParametrizedTest, updateNeighborsStateFromEdgeMove_fromRemovedEdge_expectCorrectionInNeighborState)
+    TEST_P(DynamicsParametrizedTest, getLogLikelihoodRatio_forRemovedAbsentEdge_throwLogicError)
     {
         dynamics.sampleState();
-        BaseGraph::Edge edge = GRAPH_MOVE.removedEdges[0];
-        map<BaseGraph::VertexIndex, VertexNeighborhoodStateSequence> actualBefore, actualAfter;
-
-        dynamics.updateNeighborsStateFromEdgeMove(edge, -1, actualBefore, actualAfter);
-
-        auto expectedBefore = dynamics.getNeighborsPastStates();
-        dynamics.applyGraphMove({{edge}, {}});
-        auto expectedAfter = dynamics.getNeighborsPastStates();
-
-        for (auto actual : actualBefore)
-            for (size_t t = 0; t < dynamics.getLength(); ++t)
-                for (size_t s = 0; s < dynamics.getNumStates(); ++s)
-                    EXPECT_EQ(expectedBefore[actual.first][t][s], actual.second[t][s]);
+        EXPECT_THROW(dynamics.getLogLikelihoodRatioFromGraphMove({{{1, 6}}, {}}), std::logic_error);
+        EXPECT_THROW(dynamics.applyGraphMove({{{1, 6}}, {}}), std::logic_error);
+    }
 
-        for (auto actual : actualAfter)
-            for (size_t t = 0; t < dynamics.getLength(); ++t)
-                for (size_t s = 0; s < dynamics.getNumStates(); ++s)
-                    EXPECT_EQ(expectedAfter[actual.first][t][s], actual.second[t][s]);
+    TEST_P(DynamicsParametrizedTest, sampleNextState_givenUniform_invertCumulativeProbs)
+    {
+        expectConsistencyError = false;
+        for (double uniform : {0., 0.2, 0.33})
+            EXPECT_EQ(dynamics.sampleNextState(0, NEIGHBORS_STATE[0], uniform), 0);
+        for (double uniform : {0.34, 0.5, 0.66})
+            EXPECT_EQ(dynamics.sampleNextState(0, NEIGHBORS_STATE[0], uniform), 1);
+        for (double uniform : {0.67, 0.9, 0.999999})
+            EXPECT_EQ(dynamics.sampleNextState(0, NEIGHBORS_STATE[0], uniform), 2);
     }
 
     INSTANTIATE_TEST_SUITE_P(
@@ -36,6 +36,18 @@ namespace GraphInf
         }
     }
 
+    TEST_F(TestGlauberDynamics, getLogTransitionProb_afterSetCoupling_sameAsTransitionProb)
+    {
+        dynamics.sample();
+        dynamics.setCoupling(0.5);
+        for (int inactive = 0; inactive < 40; inactive++)
+            for (int active = 0; active < 40; active++)
+                for (VertexState prev = 0; prev < 2; prev++)
+                    for (VertexState next = 0; next < 2; next++)
+                        EXPECT_EQ(log(dynamics.getTransitionProb(prev, next, {inactive, active})),
+                                  dynamics.getLogTransitionProb(prev, next, {inactive, active}));
+    }
+
     TEST_F(TestGlauberDynamics, getDeactivationProb_forEachStateTransition_returnCorrectProbability)
     {
         for (auto neighborState : NEIGHBOR_STATES)
@@ -111,7 +123,7 @@ namespace GraphInf
     {
         dynamics.sample();
         MCMCSummary summary = {};
-        while (summary.accepted.size() == 0)
+        while (summary.getAcceptedCount() == 0)
             summary.update(dynamics.metropolisGraphStep());
         dynamics.checkConsistency();
     }
@@ -120,7 +132,7 @@ namespace GraphInf
     {
         dynamics.sample();
         MCMCSummary summary = {};
-        while (summary.accepted.size() == 0)
+        while (summary.getAcceptedCount() == 0)
             summary.update(dynamics.metropolisParamStep());
         dynamics.checkConsistency();
     }
@@ -0,0 +1,86 @@
+#include "gtest/gtest.h"
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "GraphInf/data/dynamics/log_transition_kernels.h"
+
+namespace GraphInf
+{
+
+    class TestLogTransitionKernels : public ::testing::Test
+    {
+    public:
+        const int INACTIVE_SIZE = 6, ACTIVE_SIZE = 8;
+        const size_t LENGTH = 103;
+        std::vector<double> values;
+        std::vector<VertexState> past, future, counts, otherPast;
+        LogTransitionTable table;
+
+        void SetUp()
+        {
+            std::mt19937 rng(7);
+            std::uniform_real_distribution<double> logProb(-5, 0);
+            values.resize(4 * INACTIVE_SIZE * ACTIVE_SIZE);
+            for (auto &value : values)
+                value = logProb(rng);
+            for (size_t t = 0; t < LENGTH; t++)
+            {
+                past.push_back(rng() % 2);
+                future.push_back(rng() % 2);
+                otherPast.push_back(rng() % 2);
+                counts.push_back(1 + rng() % (INACTIVE_SIZE - 2));
+                counts.push_back(1 + rng() % (ACTIVE_SIZE - 2));
+            }
+            table = {values.data(), ACTIVE_SIZE, INACTIVE_SIZE, ACTIVE_SIZE};
+        }
+
+        double naiveSum(const NeighborShift *shifts, size_t numShifts) const
+        {
+            double sum = 0;
+            for (size_t t = 0; t < LENGTH; t++)
+            {
+                int inactive = counts[2 * t], active = counts[2 * t + 1];
+                for (size_t i = 0; i < numShifts; i++)
+                {
+                    active += shifts[i].counter * shifts[i].states[t];
+                    inactive += shifts[i].counter * (1 - shifts[i].states[t]);
+                }
+                sum += values[4 * (inactive * ACTIVE_SIZE + active) + 2 * past[t] + future[t]];
+            }
+            return sum;
+        }
+    };
+
+    TEST_F(TestLogTransitionKernels, sumLogTransitions_givenEachSimdLevel_sameSumAsScalar)
+    {
+        const NeighborShift shifts[2] = {{otherPast.data(), 1}, {past.data(), -1}};
+        for (size_t numShifts = 0; numShifts <= 2; numShifts++)
+        {
+            double expected, actual;
+            ASSERT_TRUE(sumLogTransitions(table, past.data(), future.data(), counts.data(), shifts, numShifts, LENGTH, expected, SimdLevel::Scalar));
+            EXPECT_NEAR(expected, naiveSum(shifts, numShifts), 1e-9);
+            for (auto level : {SimdLevel::SSE4, SimdLevel::AVX2})
+            {
+                ASSERT_TRUE(sumLogTransitions(table, past.data(), future.data(), counts.data(), shifts, numShifts, LENGTH, actual, level));
+                EXPECT_EQ(expected, actual);
+            }
+        }
+    }
+
+    TEST_F(TestLogTransitionKernels, sumLogTransitions_forCountOutsideTable_returnFalse)
+    {
+        double sum;
+        for (auto level : {SimdLevel::Scalar, SimdLevel::SSE4, SimdLevel::AVX2})
+        {
+            counts[2 * 50 + 1] = ACTIVE_SIZE;
+            EXPECT_FALSE(sumLogTransitions(table, past.data(), future.data(), counts.data(), nullptr, 0, LENGTH, sum, level));
+            counts[2 * 50 + 1] = 0;
+            const NeighborShift shift = {past.data(), -1};
+            std::fill(past.begin(), past.end(), 1);
+            EXPECT_FALSE(sumLogTransitions(table, past.data(), future.data(), counts.data(), &shift, 1, LENGTH, sum, level));
+            counts[2 * 50 + 1] = 1;
+        }
+    }
+
+}
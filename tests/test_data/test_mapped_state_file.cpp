@@ -0,0 +1,71 @@
+#include "gtest/gtest.h"
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "GraphInf/data/dynamics/mapped_state_file.h"
+
+namespace GraphInf
+{
+
+    // Writes `values` as a version 1 `.npy` file with the given header fields.
+    static void writeNpyFile(const std::string &path, const std::vector<int> &values, const std::string &descr, const std::string &shape)
+    {
+        std::string header = "{'descr': '" + descr + "', 'fortran_order': False, 'shape': " + shape + ", }";
+        header.append(64 - (10 + header.size() + 1) % 64, ' ');
+        header += '\n';
+        std::ofstream file(path, std::ios::binary);
+        file.write("\x93NUMPY\x01\x00", 8);
+        const unsigned char length[2] = {(unsigned char)(header.size() & 0xff), (unsigned char)(header.size() >> 8)};
+        file.write(reinterpret_cast<const char *>(length), 2);
+        file.write(header.data(), header.size());
+        file.write(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(int));
+    }
+
+    class TestMappedStateFile : public ::testing::Test
+    {
+    public:
+        const std::vector<int> VALUES = {0, 1, 1, 0, 2, 1};
+        const std::string PATH = ::testing::TempDir() + "graphinf_test_mapped_state_file";
+        void TearDown() { std::remove(PATH.c_str()); }
+    };
+
+    TEST_F(TestMappedStateFile, construct_forNpyFile_readShapeAndValues)
+    {
+        writeNpyFile(PATH, VALUES, "<i4", "(2, 3)");
+        MappedStateFile file(PATH);
+        EXPECT_EQ(file.getShape(), std::vector<size_t>({2, 3}));
+        EXPECT_EQ(file.size(), 6);
+        EXPECT_EQ(std::vector<int>(file.data(), file.data() + file.size()), VALUES);
+    }
+
+    TEST_F(TestMappedStateFile, construct_forRawFile_readFlatValues)
+    {
+        {
+            std::ofstream raw(PATH, std::ios::binary);
+            raw.write(reinterpret_cast<const char *>(VALUES.data()), VALUES.size() * sizeof(int));
+        }
+        MappedStateFile file(PATH);
+        EXPECT_EQ(file.getShape(), std::vector<size_t>({6}));
+        EXPECT_EQ(std::vector<int>(file.data(), file.data() + file.size()), VALUES);
+    }
+
+    TEST_F(TestMappedStateFile, construct_forOtherDtype_throwRuntimeError)
+    {
+        writeNpyFile(PATH, VALUES, "<f8", "(3,)");
+        EXPECT_THROW(MappedStateFile file(PATH), std::runtime_error);
+    }
+
+    TEST_F(TestMappedStateFile, construct_forTruncatedData_throwRuntimeError)
+    {
+        writeNpyFile(PATH, VALUES, "<i4", "(3, 3)");
+        EXPECT_THROW(MappedStateFile file(PATH), std::runtime_error);
+    }
+
+    TEST_F(TestMappedStateFile, construct_forMissingFile_throwRuntimeError)
+    {
+        EXPECT_THROW(MappedStateFile file(PATH + "_missing"), std::runtime_error);
+    }
+
+}
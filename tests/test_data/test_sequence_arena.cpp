@@ -0,0 +1,240 @@
+#include "gtest/gtest.h"
+#include <vector>
+
+#include "GraphInf/data/dynamics/sequence_arena.hpp"
+
+namespace GraphInf
+{
+
+    class TestSequenceArena : public ::testing::TestWithParam<SequenceLayout>
+    {
+    public:
+        const Matrix<int> VALUES = {{0, 1, 2, 3}, {4, 5, 6, 7}, {8, 9, 10, 11}};
+        SequenceArena<int> arena = SequenceArena<int>(1, GetParam());
+        SequenceArena<int> cells = SequenceArena<int>(2, GetParam());
+        void SetUp()
+        {
+            arena.assign(VALUES);
+            cells.resize(VALUES.size(), VALUES[0].size());
+            for (size_t v = 0; v < VALUES.size(); ++v)
+                for (size_t t = 0; t < VALUES[v].size(); ++t)
+                {
+                    cells.at(v, t)[0] = VALUES[v][t];
+                    cells.at(v, t)[1] = -VALUES[v][t];
+                }
+        }
+    };
+
+    TEST_P(TestSequenceArena, assign_forMatrix_cellsHoldValues)
+    {
+        EXPECT_EQ(arena.size(), 3);
+        EXPECT_EQ(arena.getLength(), 4);
+        for (size_t v = 0; v < VALUES.size(); ++v)
+            for (size_t t = 0; t < VALUES[v].size(); ++t)
+                EXPECT_EQ(*arena.at(v, t), VALUES[v][t]);
+    }
+
+    TEST_P(TestSequenceArena, assignExternal_forFlatValues_readInPlaceUntilWritten)
+    {
+        std::vector<int> values(12);
+        for (size_t i = 0; i < values.size(); ++i)
+            values[i] = i;
+        SequenceArena<int> external;
+        external.assignExternal(values.data(), 3, 4, GetParam(), nullptr);
+        const SequenceArena<int> &view = external;
+        EXPECT_TRUE(external.isExternal());
+        EXPECT_EQ(view.data(), values.data());
+        EXPECT_EQ(external.getLayout(), GetParam());
+        EXPECT_EQ(*view.at(1, 2), (GetParam() == SequenceLayout::VertexMajor) ? 6 : 7);
+
+        *external.at(1, 2) = -1;
+        EXPECT_FALSE(external.isExternal());
+        EXPECT_EQ(*view.at(1, 2), -1);
+        EXPECT_EQ(*view.at(2, 3), 11);
+        EXPECT_EQ(values[6], 6);
+        EXPECT_EQ(values[7], 7);
+    }
+
+    TEST_P(TestSequenceArena, setLength_givenLongerLength_keepCellsAndClearNewOnes)
+    {
+        arena.setLength(6);
+        EXPECT_EQ(arena.getLength(), 6);
+        for (size_t v = 0; v < VALUES.size(); ++v)
+        {
+            for (size_t t = 0; t < VALUES[v].size(); ++t)
+                EXPECT_EQ(*arena.at(v, t), VALUES[v][t]);
+            EXPECT_EQ(*arena.at(v, 4), 0);
+            EXPECT_EQ(*arena.at(v, 5), 0);
+        }
+    }
+
+    TEST_P(TestSequenceArena, eraseFront_givenCount_dropFirstSteps)
+    {
+        cells.eraseFront(3);
+        EXPECT_EQ(cells.getLength(), 1);
+        for (size_t v = 0; v < VALUES.size(); ++v)
+        {
+            EXPECT_EQ(cells.at(v, 0)[0], VALUES[v][3]);
+            EXPECT_EQ(cells.at(v, 0)[1], -VALUES[v][3]);
+        }
+    }
+
+    TEST_P(TestSequenceArena, eraseFront_slidingWindow_keepLatestSteps)
+    {
+        SequenceArena<int> window(1, GetParam());
+        window.resize(3, 4);
+        for (size_t step = 0; step < 20; ++step)
+        {
+            window.setLength(5);
+            for (size_t v = 0; v < 3; ++v)
+                *window.at(v, 4) = 10 * step + v;
+            window.eraseFront(1);
+        }
+        ASSERT_EQ(window.getLength(), 4);
+        const SequenceArena<int> &view = window;
+        for (size_t v = 0; v < 3; ++v)
+            for (size_t t = 0; t < 4; ++t)
+                EXPECT_EQ(*view.at(v, t), 10 * (16 + t) + v);
+    }
+
+    TEST_P(TestSequenceArena, eraseFront_forExternalCells_keepValues)
+    {
+        std::vector<int> values(12);
+        for (size_t i = 0; i < values.size(); ++i)
+            values[i] = i;
+        SequenceArena<int> external;
+        external.assignExternal(values.data(), 3, 4, GetParam(), nullptr);
+        external.eraseFront(1);
+        const SequenceArena<int> &view = external;
+        EXPECT_EQ(external.isExternal(), GetParam() == SequenceLayout::TimeMajor);
+        EXPECT_EQ(*view.at(1, 0), (GetParam() == SequenceLayout::VertexMajor) ? 5 : 4);
+        EXPECT_EQ(*view.at(2, 2), 11);
+    }
+
+    TEST_P(TestSequenceArena, assign_forRaggedMatrix_throwLogicError)
+    {
+        EXPECT_THROW(arena.assign({{0, 1}, {2}}), std::logic_error);
+    }
+
+    TEST_P(TestSequenceArena, strides_forEachLayout_addressConsecutiveCells)
+    {
+        EXPECT_EQ(arena.at(1, 2) + arena.getTimeStride(), arena.at(1, 3));
+        EXPECT_EQ(arena.at(1, 2) + arena.getVertexStride(), arena.at(2, 2));
+        EXPECT_EQ(cells.at(1, 2) + cells.getTimeStride(), cells.at(1, 3));
+        EXPECT_EQ(cells.at(1, 2) + cells.getVertexStride(), cells.at(2, 2));
+    }
+
+    TEST_P(TestSequenceArena, setLayout_forOtherLayout_keepValues)
+    {
+        auto other = (GetParam() == SequenceLayout::VertexMajor) ? SequenceLayout::TimeMajor : SequenceLayout::VertexMajor;
+        arena.setLayout(other);
+        cells.setLayout(other);
+        EXPECT_EQ(arena.getLayout(), other);
+        EXPECT_EQ(Matrix<int>(SequenceView<int>(arena)), VALUES);
+        for (size_t v = 0; v < VALUES.size(); ++v)
+            for (size_t t = 0; t < VALUES[v].size(); ++t)
+                EXPECT_EQ(std::vector<int>(CellSequenceView<int>(cells)[v][t]), std::vector<int>({VALUES[v][t], -VALUES[v][t]}));
+    }
+
+    TEST_P(TestSequenceArena, views_givenFirstStep_skipEarlierSteps)
+    {
+        EXPECT_EQ(Matrix<int>(SequenceView<int>(arena, 1, 2)), Matrix<int>({{1, 2}, {5, 6}, {9, 10}}));
+    }
+
+    TEST_P(TestSequenceArena, views_forEachLayout_indexLikeNestedVectors)
+    {
+        SequenceView<int> view(arena);
+        CellSequenceView<int> cellView(cells);
+        EXPECT_EQ(view.size(), 3);
+        EXPECT_EQ(view[0].size(), 4);
+        EXPECT_EQ(cellView[0][0].size(), 2);
+        for (size_t v = 0; v < VALUES.size(); ++v)
+        {
+            EXPECT_EQ(std::vector<int>(view[v]), VALUES[v]);
+            for (size_t t = 0; t < VALUES[v].size(); ++t)
+            {
+                EXPECT_EQ(view[v][t], VALUES[v][t]);
+                EXPECT_EQ(cellView[v][t][1], -VALUES[v][t]);
+            }
+        }
+    }
+
+    TEST(TestPackedStateSequence, assign_forBinaryMatrix_viewsHoldStates)
+    {
+        Matrix<int> states(130, std::vector<int>(3));
+        for (size_t v = 0; v < states.size(); ++v)
+            for (size_t t = 0; t < 3; ++t)
+                states[v][t] = (v * 7 + t) % 3 == 0;
+        PackedStateSequence packed;
+        packed.assign(states);
+        EXPECT_EQ(packed.getNumWords(), 3);
+        EXPECT_EQ(Matrix<int>(SequenceView<int>(packed)), states);
+        std::vector<int> series(3);
+        packed.unpack(129, series.data(), 0, 3);
+        EXPECT_EQ(series, states[129]);
+    }
+
+    TEST(TestPackedStateSequence, views_givenFirstStep_skipEarlierSteps)
+    {
+        const Matrix<int> states = {{0, 1, 1}, {1, 0, 1}};
+        PackedStateSequence packed;
+        packed.assign(states);
+        EXPECT_EQ(Matrix<int>(SequenceView<int>(packed, 1, 2)), Matrix<int>({{1, 1}, {0, 1}}));
+    }
+
+    TEST(TestPackedStateSequence, setLengthAndEraseFront_givenSteps_shiftTimeAxis)
+    {
+        PackedStateSequence packed;
+        packed.assign(Matrix<int>({{0, 1, 1}, {1, 0, 1}}));
+        packed.setLength(4);
+        packed.set(0, 3, true);
+        packed.eraseFront(2);
+        EXPECT_EQ(packed.getLength(), 2);
+        EXPECT_EQ(Matrix<int>(SequenceView<int>(packed)), Matrix<int>({{1, 1}, {1, 0}}));
+    }
+
+    TEST(TestPackedStateSequence, eraseFront_slidingWindow_keepLatestSteps)
+    {
+        PackedStateSequence packed;
+        packed.resize(70, 3);
+        for (size_t step = 0; step < 20; ++step)
+        {
+            packed.setLength(4);
+            packed.set(69, 3, step % 2);
+            packed.set(step % 70, 3, true);
+            packed.eraseFront(1);
+        }
+        ASSERT_EQ(packed.getLength(), 3);
+        for (size_t t = 0; t < 3; ++t)
+        {
+            const size_t step = 17 + t;
+            EXPECT_EQ(packed.get(69, t), step % 2 == 1);
+            EXPECT_TRUE(packed.get(step, t));
+            EXPECT_FALSE(packed.get(step + 1, t));
+        }
+    }
+
+    TEST(TestPackedStateSequence, assign_forNonBinaryMatrix_throwLogicError)
+    {
+        PackedStateSequence packed;
+        EXPECT_THROW(packed.assign(Matrix<int>({{0, 1}, {2, 0}})), std::logic_error);
+    }
+
+    TEST(TestPackedStateSequence, countActive_givenMasks_returnWeightedActiveCount)
+    {
+        PackedStateSequence packed;
+        packed.resize(100, 2);
+        for (size_t v : {3, 5, 70, 99})
+            packed.set(v, 1, true);
+        packed.set(5, 1, false);
+        const std::vector<PackedVertexMask> masks = {{0, (1ULL << 3) | (1ULL << 5), 1}, {1, 1ULL << (70 - 64), 2}, {1, 1ULL << (99 - 64), 1}};
+        EXPECT_EQ(packed.countActive(masks.data(), masks.size(), 0), 0);
+        EXPECT_EQ(packed.countActive(masks.data(), masks.size(), 1), 4);
+    }
+
+    INSTANTIATE_TEST_SUITE_P(
+        SequenceArenaTests,
+        TestSequenceArena,
+        ::testing::Values(SequenceLayout::VertexMajor, SequenceLayout::TimeMajor));
+
+}
@@ -1,5 +1,8 @@
 #include "gtest/gtest.h"
+#include <cstdio>
+#include <fstream>
 #include <list>
+#include <random>
 #include <cmath>
 
 #include "GraphInf/data/dynamics/sis.h"
@@ -74,6 +77,42 @@ namespace GraphInf
         EXPECT_NEAR(expected, actual, 1E-6);
     }
 
+    TEST_F(TestSISDynamics, setSequenceLayout_forTimeMajor_sameStatesAndLikelihood)
+    {
+        dynamics.sample();
+        Matrix<VertexState> past = dynamics.getPastStates(), future = dynamics.getFutureStates();
+        Matrix<VertexNeighborhoodState> neighborsPast = dynamics.getNeighborsPastStates();
+        double logLikelihood = dynamics.getLogLikelihood();
+        auto graphMove = randomGraph.proposeGraphMove();
+        double ratio = dynamics.getLogLikelihoodRatioFromGraphMove(graphMove);
+
+        dynamics.setSequenceLayout(SequenceLayout::TimeMajor);
+        EXPECT_EQ(past, Matrix<VertexState>(dynamics.getPastStates()));
+        EXPECT_EQ(future, Matrix<VertexState>(dynamics.getFutureStates()));
+        EXPECT_EQ(neighborsPast, Matrix<VertexNeighborhoodState>(dynamics.getNeighborsPastStates()));
+        EXPECT_EQ(logLikelihood, dynamics.getLogLikelihood());
+        EXPECT_EQ(ratio, dynamics.getLogLikelihoodRatioFromGraphMove(graphMove));
+        dynamics.applyGraphMove(graphMove);
+        dynamics.checkConsistency();
+    }
+
+    TEST_F(TestSISDynamics, setState_forTrajectory_splitIntoPastAndFuture)
+    {
+        dynamics.sample();
+        Matrix<VertexState> past = dynamics.getPastStates(), future = dynamics.getFutureStates();
+        Matrix<VertexState> trajectory = past;
+        for (size_t v = 0; v < trajectory.size(); ++v)
+            trajectory[v].push_back(future[v].back());
+        double logLikelihood = dynamics.getLogLikelihood();
+
+        dynamics.setState(trajectory);
+        EXPECT_EQ(dynamics.getLength(), NUM_STEPS);
+        EXPECT_EQ(past, Matrix<VertexState>(dynamics.getPastStates()));
+        EXPECT_EQ(future, Matrix<VertexState>(dynamics.getFutureStates()));
+        EXPECT_EQ(logLikelihood, dynamics.getLogLikelihood());
+        dynamics.checkConsistency();
+    }
+
     TEST_F(TestSISDynamics, getLogLikelihoodRatio_forSomeGraphMove_returnLogJointRatio)
     {
         dynamics.sample();
@@ -85,11 +124,495 @@ namespace GraphInf
 
         EXPECT_NEAR(ratio, logLikelihoodAfter - logLikelihoodBefore, 1e-6);
     }
+    TEST_F(TestSISDynamics, getLogLikelihoodRatio_forMoveSharingVertices_returnLikelihoodDifference)
+    {
+        dynamics.sample();
+        const auto edge = *dynamics.getGraph().edges().begin();
+        BaseGraph::VertexIndex other = 0;
+        while (other == edge.first or other == edge.second)
+            other++;
+        GraphMove graphMove = {{edge}, {{edge.first, other}, {other, edge.second}, {other, edge.second}}};
+        double ratio = dynamics.getLogLikelihoodRatioFromGraphMove(graphMove);
+        double logLikelihoodBefore = dynamics.getLogLikelihood();
+        dynamics.applyGraphMove(graphMove);
+        dynamics.checkConsistency();
+
+        EXPECT_NEAR(ratio, dynamics.getLogLikelihood() - logLikelihoodBefore, 1e-6);
+    }
+
+    TEST_F(TestSISDynamics, getLogLikelihoodRatio_forSelfLoop_returnLikelihoodDifference)
+    {
+        dynamics.acceptSelfLoops(true);
+        dynamics.sample();
+        GraphMove graphMove = {{}, {{3, 3}}};
+        double ratio = dynamics.getLogLikelihoodRatioFromGraphMove(graphMove);
+        double logLikelihoodBefore = dynamics.getLogLikelihood();
+        dynamics.applyGraphMove(graphMove);
+        dynamics.checkConsistency();
+
+        EXPECT_NEAR(ratio, dynamics.getLogLikelihood() - logLikelihoodBefore, 1e-6);
+    }
+
+    TEST_F(TestSISDynamics, getLogLikelihood_afterGraphAndParamSteps_sameWithAndWithoutCache)
+    {
+        dynamics.sample();
+        for (size_t i = 0; i < 50; i++)
+        {
+            dynamics.metropolisGraphStep();
+            dynamics.metropolisParamStep();
+            auto graphMove = randomGraph.proposeGraphMove();
+            double cachedLogLikelihood = dynamics.getLogLikelihood();
+            double cachedRatio = dynamics.getLogLikelihoodRatioFromGraphMove(graphMove);
+
+            dynamics.setLogLikelihoodCaching(false);
+            EXPECT_NEAR(cachedLogLikelihood, dynamics.getLogLikelihood(), 1e-6);
+            EXPECT_NEAR(cachedRatio, dynamics.getLogLikelihoodRatioFromGraphMove(graphMove), 1e-6);
+            dynamics.setLogLikelihoodCaching(true);
+        }
+        dynamics.checkConsistency();
+    }
+
+    TEST_F(TestSISDynamics, setInfectionProb_withCache_updateLogLikelihood)
+    {
+        dynamics.sample();
+        dynamics.setInfectionProb(0.2);
+        double cachedLogLikelihood = dynamics.getLogLikelihood();
+        dynamics.setLogLikelihoodCaching(false);
+        EXPECT_NEAR(cachedLogLikelihood, dynamics.getLogLikelihood(), 1e-6);
+    }
+
+    TEST_F(TestSISDynamics, getLogLikelihoodRatioFromParaMove_withCache_sameAsWithoutCache)
+    {
+        dynamics.sample();
+        for (const ParamMove &move : {ParamMove("infection", -0.2), ParamMove("recovery", 0.1), ParamMove("activation", 1e-3)})
+        {
+            double logLikelihood = dynamics.getLogLikelihood();
+            double cachedRatio = dynamics.getLogLikelihoodRatioFromParaMove(move);
+            EXPECT_EQ(logLikelihood, dynamics.getLogLikelihood());
+            dynamics.setLogLikelihoodCaching(false);
+            EXPECT_NEAR(cachedRatio, dynamics.getLogLikelihoodRatioFromParaMove(move), 1e-6);
+            dynamics.setLogLikelihoodCaching(true);
+        }
+    }
+
+    TEST_F(TestSISDynamics, applyParamMove_thenGraphMoves_cacheMatchesFreshComputation)
+    {
+        dynamics.sample();
+        dynamics.applyParamMove({"infection", -0.2});
+        for (size_t i = 0; i < 20; i++)
+        {
+            const auto move = randomGraph.proposeGraphMove();
+            const double cachedRatio = dynamics.getLogLikelihoodRatioFromGraphMove(move);
+            dynamics.setLogLikelihoodCaching(false);
+            EXPECT_NEAR(cachedRatio, dynamics.getLogLikelihoodRatioFromGraphMove(move), 1e-6);
+            dynamics.setLogLikelihoodCaching(true);
+            dynamics.applyParamMove({"recovery", (i % 2 == 0) ? 0.01 : -0.01});
+            dynamics.applyGraphMove(move);
+        }
+        dynamics.checkConsistency();
+        const double cachedLogLikelihood = dynamics.getLogLikelihood();
+        dynamics.setLogLikelihoodCaching(false);
+        EXPECT_NEAR(cachedLogLikelihood, dynamics.getLogLikelihood(), 1e-6);
+    }
+
+    TEST_F(TestSISDynamics, getTransitionCounts_afterGraphMoves_countEveryTransition)
+    {
+        dynamics.sample();
+        for (size_t i = 0; i < 20; i++)
+            dynamics.applyGraphMove(randomGraph.proposeGraphMove());
+        size_t count = 0;
+        for (const auto &transition : dynamics.getTransitionCounts())
+            count += transition.second;
+        EXPECT_EQ(count, randomGraph.getSize() * NUM_STEPS);
+        dynamics.checkConsistency();
+    }
+
+    TEST_F(TestSISDynamics, setState_givenThreadCounts_sameLogLikelihoodAndCounts)
+    {
+        ErdosRenyiModel graph(200, 400);
+        SISDynamics serial(graph, NUM_STEPS, INFECTION_PROB, RECOVERY_PROB);
+        serial.sample();
+        const Matrix<VertexState> past = serial.getPastStates(), future = serial.getFutureStates();
+        const double logLikelihood = serial.getLogLikelihood();
+        for (size_t threadCount : {2, 4})
+        {
+            SISDynamics parallel(graph, NUM_STEPS, INFECTION_PROB, RECOVERY_PROB);
+            parallel.setThreadCount(threadCount);
+            parallel.sampleState();
+            parallel.setState(past, future);
+            EXPECT_EQ(logLikelihood, parallel.getLogLikelihood());
+            EXPECT_EQ(serial.getTransitionCounts(), parallel.getTransitionCounts());
+            EXPECT_EQ(Matrix<std::vector<VertexState>>(serial.getNeighborsPastStates()), Matrix<std::vector<VertexState>>(parallel.getNeighborsPastStates()));
+            EXPECT_EQ(serial.getNeighborsState(), parallel.computeNeighborsState(serial.getState()));
+            parallel.setLogLikelihoodCaching(false);
+            EXPECT_EQ(logLikelihood, parallel.getLogLikelihood());
+        }
+        serial.setLogLikelihoodCaching(false);
+        EXPECT_EQ(logLikelihood, serial.getLogLikelihood());
+    }
+
+    TEST_F(TestSISDynamics, getLogLikelihoodRatioFromGraphMove_givenLayouts_sameRatio)
+    {
+        dynamics.sample();
+        for (size_t i = 0; i < 20; i++)
+        {
+            auto move = randomGraph.proposeGraphMove();
+            dynamics.setSequenceLayout(SequenceLayout::VertexMajor);
+            double ratio = dynamics.getLogLikelihoodRatioFromGraphMove(move);
+            dynamics.setSequenceLayout(SequenceLayout::TimeMajor);
+            EXPECT_NEAR(ratio, dynamics.getLogLikelihoodRatioFromGraphMove(move), 1e-9);
+        }
+    }
+
+    TEST_F(TestSISDynamics, setNeighborsPastStateCaching_withoutStoredCounts_sameRatios)
+    {
+        dynamics.sample();
+        for (auto layout : {SequenceLayout::VertexMajor, SequenceLayout::TimeMajor})
+        {
+            dynamics.setSequenceLayout(layout);
+            for (size_t i = 0; i < 10; i++)
+            {
+                auto move = randomGraph.proposeGraphMove();
+                dynamics.setNeighborsPastStateCaching(true);
+                double ratio = dynamics.getLogLikelihoodRatioFromGraphMove(move);
+                dynamics.setNeighborsPastStateCaching(false);
+                EXPECT_EQ(ratio, dynamics.getLogLikelihoodRatioFromGraphMove(move));
+                dynamics.applyGraphMove(move);
+            }
+            dynamics.checkConsistency();
+        }
+    }
+
+    TEST_F(TestSISDynamics, sampleNextState_givenUniform_sameAsCumulativeInversion)
+    {
+        for (const auto &neighborState : neighbor_states)
+            for (VertexState prev = 0; prev < 2; prev++)
+                for (double uniform = 0; uniform < 1; uniform += 0.01)
+                    EXPECT_EQ(dynamics.sampleNextState(prev, neighborState, uniform),
+                              dynamics.Dynamics::sampleNextState(prev, neighborState, uniform));
+    }
+
+    TEST_F(TestSISDynamics, sampleState_givenThreadCounts_sameTrajectory)
+    {
+        ErdosRenyiModel graph(300, 600);
+        SISDynamics model(graph, NUM_STEPS, INFECTION_PROB, RECOVERY_PROB);
+        seed(5);
+        model.sample({}, false, 3);
+        const Matrix<VertexState> past = model.getPastStates(), future = model.getFutureStates();
+        for (size_t threadCount : {2, 4})
+        {
+            model.setThreadCount(threadCount);
+            seed(5);
+            model.sample({}, false, 3);
+            EXPECT_EQ(past, Matrix<VertexState>(model.getPastStates()));
+            EXPECT_EQ(future, Matrix<VertexState>(model.getFutureStates()));
+            model.checkConsistency();
+        }
+    }
+
+    TEST_F(TestSISDynamics, setStatePacking_afterSample_sameLikelihoodAndRatios)
+    {
+        ErdosRenyiModel graph(200, 400);
+        SISDynamics model(graph, NUM_STEPS, INFECTION_PROB, RECOVERY_PROB);
+        model.sample();
+        const Matrix<VertexState> past = model.getPastStates(), future = model.getFutureStates();
+        const TransitionCounts counts = model.getTransitionCounts();
+        std::vector<GraphMove> moves;
+        std::vector<double> ratios;
+        for (size_t i = 0; i < 20; i++)
+        {
+            moves.push_back(graph.proposeGraphMove());
+            ratios.push_back(model.getLogLikelihoodRatioFromGraphMove(moves.back()));
+        }
+        const double logLikelihood = model.getLogLikelihood();
+
+        model.setStatePacking(true);
+        EXPECT_EQ(past, Matrix<VertexState>(model.getPastStates()));
+        EXPECT_EQ(future, Matrix<VertexState>(model.getFutureStates()));
+        EXPECT_EQ(model.getNeighborsPastStates().size(), 0);
+        for (size_t i = 0; i < moves.size(); i++)
+            EXPECT_EQ(ratios[i], model.getLogLikelihoodRatioFromGraphMove(moves[i]));
+        model.setState(past, future);
+        EXPECT_EQ(counts, model.getTransitionCounts());
+        EXPECT_EQ(logLikelihood, model.getLogLikelihood());
+        model.checkConsistency();
+
+        for (size_t i = 0; i < 20; i++)
+            model.applyGraphMove(graph.proposeGraphMove());
+        model.checkConsistency();
+        const double movedLogLikelihood = model.getLogLikelihood();
+        model.setStatePacking(false);
+        model.checkConsistency();
+        model.setLogLikelihoodCaching(false);
+        EXPECT_NEAR(movedLogLikelihood, model.getLogLikelihood(), 1e-9);
+    }
+
+    TEST_F(TestSISDynamics, setState_givenUnrelatedPairs_keepPairs)
+    {
+        dynamics.sample();
+        const Matrix<VertexState> past = dynamics.getPastStates();
+        Matrix<VertexState> future = dynamics.getFutureStates();
+        future[0][0] = 1 - future[0][0];
+        for (bool pack : {false, true})
+        {
+            dynamics.setStatePacking(pack);
+            dynamics.setState(past, future);
+            EXPECT_EQ(past, Matrix<VertexState>(dynamics.getPastStates()));
+            EXPECT_EQ(future, Matrix<VertexState>(dynamics.getFutureStates()));
+            const double logLikelihood = dynamics.getLogLikelihood();
+            dynamics.setLogLikelihoodCaching(false);
+            EXPECT_EQ(logLikelihood, dynamics.getLogLikelihood());
+            dynamics.setLogLikelihoodCaching(true);
+            for (size_t i = 0; i < 10; i++)
+                dynamics.applyGraphMove(randomGraph.proposeGraphMove());
+            dynamics.checkConsistency();
+        }
+    }
+
+    TEST_F(TestSISDynamics, setStateFromFile_givenOutOfRangeState_throwLogicErrorAndKeepStates)
+    {
+        dynamics.sample();
+        const Matrix<VertexState> past = dynamics.getPastStates();
+        const std::string path = ::testing::TempDir() + "graphinf_test_sis_invalid_states.npy";
+        for (VertexState invalid : {-1, 2})
+        {
+            std::vector<VertexState> values(10 * (NUM_STEPS + 1), 0);
+            values[3 * (NUM_STEPS + 1) + 5] = invalid;
+            std::string header = "{'descr': '<i4', 'fortran_order': False, 'shape': (10, " + std::to_string(NUM_STEPS + 1) + "), }";
+            header.append(64 - (10 + header.size() + 1) % 64, ' ');
+            header += '\n';
+            {
+                std::ofstream file(path, std::ios::binary);
+                file.write("\x93NUMPY\x01\x00", 8);
+                const char length[2] = {char(header.size() & 0xff), char(header.size() >> 8)};
+                file.write(length, 2);
+                file.write(header.data(), header.size());
+                file.write(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(VertexState));
+            }
+            EXPECT_THROW(dynamics.setStateFromFile(path), std::logic_error);
+            EXPECT_EQ(Matrix<VertexState>(dynamics.getPastStates()), past);
+        }
+        std::remove(path.c_str());
+        dynamics.checkConsistency();
+    }
+
+    TEST_F(TestSISDynamics, setStateFromFile_givenRawTrajectory_sameAsSetState)
+    {
+        dynamics.sample();
+        const Matrix<VertexState> states = dynamics.getPastStates();
+        const std::string path = ::testing::TempDir() + "graphinf_test_sis_states";
+        for (auto layout : {SequenceLayout::VertexMajor, SequenceLayout::TimeMajor})
+            for (bool pack : {false, true})
+            {
+                std::vector<VertexState> values;
+                for (size_t i = 0; i < 10 * (NUM_STEPS + 1); i++)
+                {
+                    const size_t v = (layout == SequenceLayout::VertexMajor) ? i / (NUM_STEPS + 1) : i % 10;
+                    const size_t t = (layout == SequenceLayout::VertexMajor) ? i % (NUM_STEPS + 1) : i / 10;
+                    values.push_back((t < NUM_STEPS) ? states[v][t] : dynamics.getFutureStates()[v][NUM_STEPS - 1]);
+                }
+                {
+                    std::ofstream file(path, std::ios::binary);
+                    file.write(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(VertexState));
+                }
+                dynamics.setStatePacking(pack);
+                dynamics.setSequenceLayout(SequenceLayout::VertexMajor);
+                dynamics.setState(states, dynamics.getFutureStates());
+                const double logLikelihood = dynamics.getLogLikelihood();
+                const auto move = randomGraph.proposeGraphMove();
+                const double ratio = dynamics.getLogLikelihoodRatioFromGraphMove(move);
+
+                dynamics.setStateFromFile(path, layout);
+                EXPECT_EQ(dynamics.getLength(), NUM_STEPS);
+                EXPECT_EQ(dynamics.getSequenceLayout(), layout);
+                EXPECT_EQ(Matrix<VertexState>(dynamics.getPastStates()), states);
+                EXPECT_NEAR(dynamics.getLogLikelihood(), logLikelihood, 1e-6);
+                EXPECT_NEAR(dynamics.getLogLikelihoodRatioFromGraphMove(move), ratio, 1e-6);
+                dynamics.applyGraphMove(move);
+                EXPECT_NEAR(dynamics.getLogLikelihood(), logLikelihood + ratio, 1e-6);
+                dynamics.checkConsistency();
+            }
+        std::remove(path.c_str());
+    }
+
+    TEST_F(TestSISDynamics, appendStates_givenNextStates_sameAsSetState)
+    {
+        const size_t NUM_NEW_STEPS = 7, WINDOW = 15;
+        Matrix<VertexState> states(10);
+        for (size_t v = 0; v < 10; v++)
+            for (size_t t = 0; t <= NUM_STEPS + NUM_NEW_STEPS; t++)
+                states[v].push_back((v * 7 + t * t / 3) % 2);
+        dynamics.sample();
+        for (auto layout : {SequenceLayout::VertexMajor, SequenceLayout::TimeMajor})
+            for (bool pack : {false, true})
+                for (size_t maxLength : {size_t(0), WINDOW})
+                {
+                    const size_t length = (maxLength == 0) ? NUM_STEPS + NUM_NEW_STEPS : maxLength;
+                    Matrix<VertexState> head(10), tail(10), window(10);
+                    for (size_t v = 0; v < 10; v++)
+                    {
+                        head[v].assign(states[v].begin(), states[v].begin() + NUM_STEPS + 1);
+                        tail[v].assign(states[v].begin() + NUM_STEPS + 1, states[v].end());
+                        window[v].assign(states[v].end() - length - 1, states[v].end());
+                    }
+                    dynamics.setStatePacking(pack);
+                    dynamics.setSequenceLayout(layout);
+                    dynamics.setNeighborsPastStateCaching(maxLength == 0);
+                    dynamics.setState(window);
+                    const double logLikelihood = dynamics.getLogLikelihood();
+                    const TransitionCounts counts = dynamics.getTransitionCounts();
+
+                    dynamics.setState(head);
+                    dynamics.appendStates(tail, maxLength);
+                    EXPECT_EQ(dynamics.getLength(), length);
+                    for (size_t v = 0; v < 10; v++)
+                        EXPECT_EQ(std::vector<VertexState>(dynamics.getPastStates()[v]), std::vector<VertexState>(window[v].begin(), window[v].end() - 1));
+                    EXPECT_NEAR(dynamics.getLogLikelihood(), logLikelihood, 1e-6);
+                    EXPECT_EQ(dynamics.getTransitionCounts(), counts);
+                    dynamics.checkConsistency();
+                }
+    }
+
+    TEST_F(TestSISDynamics, appendStates_givenLongStream_cacheMatchesFreshComputation)
+    {
+        const size_t WINDOW = 15;
+        dynamics.sample();
+        dynamics.setSequenceLayout(SequenceLayout::TimeMajor);
+        std::mt19937 rng(42);
+        Matrix<VertexState> next(10, std::vector<VertexState>(1));
+        // The first append evicts 6 steps and each later one 1, so the last one completes a window turnover.
+        for (size_t step = 0; step < 10 + 15 * 333; step++)
+        {
+            for (size_t v = 0; v < 10; v++)
+                next[v][0] = rng() % 2;
+            dynamics.appendStates(next, WINDOW);
+        }
+        EXPECT_EQ(dynamics.getLength(), WINDOW);
+        dynamics.checkConsistency();
+        const double logLikelihood = dynamics.getLogLikelihood();
+        // Recomputes the cache from the retained window, as the turnover did.
+        dynamics.setLogLikelihoodCaching(true);
+        EXPECT_EQ(dynamics.getLogLikelihood(), logLikelihood);
+    }
+
+    TEST_F(TestSISDynamics, appendStates_givenUnrelatedPairs_keepPairs)
+    {
+        dynamics.sample();
+        const Matrix<VertexState> past = dynamics.getPastStates(), future = dynamics.getFutureStates();
+        Matrix<VertexState> newPast(10, std::vector<VertexState>(3)), newFuture(10, std::vector<VertexState>(3));
+        for (size_t v = 0; v < 10; v++)
+            for (size_t k = 0; k < 3; k++)
+            {
+                newPast[v][k] = (v + k) % 2;
+                newFuture[v][k] = (v * k) % 2;
+            }
+        newPast[0][0] = 1 - future[0][NUM_STEPS - 1];
+        dynamics.appendStates(newPast, newFuture);
+        EXPECT_EQ(dynamics.getLength(), NUM_STEPS + 3);
+        for (size_t v = 0; v < 10; v++)
+        {
+            std::vector<VertexState> expectedPast = past[v], expectedFuture = future[v];
+            expectedPast.insert(expectedPast.end(), newPast[v].begin(), newPast[v].end());
+            expectedFuture.insert(expectedFuture.end(), newFuture[v].begin(), newFuture[v].end());
+            EXPECT_EQ(std::vector<VertexState>(dynamics.getPastStates()[v]), expectedPast);
+            EXPECT_EQ(std::vector<VertexState>(dynamics.getFutureStates()[v]), expectedFuture);
+        }
+        dynamics.checkConsistency();
+    }
+
+    TEST_F(TestSISDynamics, setState_givenTrajectory_pastAndFutureAreOffsetViews)
+    {
+        Matrix<VertexState> states(10, std::vector<VertexState>(NUM_STEPS + 1));
+        for (size_t v = 0; v < 10; v++)
+            for (size_t t = 0; t <= NUM_STEPS; t++)
+                states[v][t] = (v + t / 3) % 2;
+        dynamics.sample();
+        for (bool pack : {false, true})
+        {
+            dynamics.setStatePacking(pack);
+            dynamics.setState(states);
+            EXPECT_EQ(dynamics.getLength(), NUM_STEPS);
+            const SequenceView<VertexState> past = dynamics.getPastStates(), future = dynamics.getFutureStates();
+            for (size_t v = 0; v < 10; v++)
+            {
+                ASSERT_EQ(past[v].size(), NUM_STEPS);
+                ASSERT_EQ(future[v].size(), NUM_STEPS);
+                for (size_t t = 0; t < NUM_STEPS; t++)
+                {
+                    EXPECT_EQ(past[v][t], states[v][t]);
+                    EXPECT_EQ(future[v][t], states[v][t + 1]);
+                }
+            }
+            dynamics.checkConsistency();
+        }
+    }
+
+    TEST_F(TestSISDynamics, sampleState_withPacking_sameTrajectory)
+    {
+        ErdosRenyiModel graph(300, 600);
+        SISDynamics model(graph, NUM_STEPS, INFECTION_PROB, RECOVERY_PROB);
+        seed(5);
+        model.sample();
+        const Matrix<VertexState> past = model.getPastStates(), future = model.getFutureStates();
+        model.setStatePacking(true);
+        seed(5);
+        model.sample();
+        EXPECT_EQ(past, Matrix<VertexState>(model.getPastStates()));
+        EXPECT_EQ(future, Matrix<VertexState>(model.getFutureStates()));
+        model.checkConsistency();
+        model.sampleStateFromEvents();
+        model.checkConsistency();
+    }
+
+    TEST_F(TestSISDynamics, sampleStateFromEvents_givenInitialState_returnConsistentSequences)
+    {
+        dynamics.sample();
+        dynamics.sampleStateFromEvents({}, 2.5);
+        const SequenceView<VertexState> past = dynamics.getPastStates(), future = dynamics.getFutureStates();
+        ASSERT_EQ(past.size(), randomGraph.getSize());
+        for (size_t v = 0; v < past.size(); v++)
+        {
+            ASSERT_EQ(past[v].size(), NUM_STEPS);
+            for (size_t t = 0; t + 1 < NUM_STEPS; t++)
+                EXPECT_EQ(future[v][t], past[v][t + 1]);
+            EXPECT_EQ(future[v][NUM_STEPS - 1], dynamics.getState()[v]);
+        }
+        dynamics.checkConsistency();
+    }
+
+    TEST_F(TestSISDynamics, sampleStateFromEvents_forRecoveryOnly_recoverAtStepProbability)
+    {
+        ErdosRenyiModel graph(2000, 2000);
+        SISDynamics model(graph, 2, 0, 0.5, 0, 0);
+        model.sample();
+        model.sampleStateFromEvents(State(2000, 1));
+        double activeFraction = 0;
+        for (size_t v = 0; v < 2000; v++)
+        {
+            EXPECT_EQ(model.getPastStates()[v][0], 1);
+            activeFraction += model.getPastStates()[v][1] / 2000.;
+        }
+        EXPECT_NEAR(activeFraction, 0.5, 0.05);
+        model.checkConsistency();
+    }
+
+    TEST_F(TestSISDynamics, getLogTransitionProb_afterParamMove_sameAsTransitionProb)
+    {
+        dynamics.sample();
+        dynamics.applyParamMove({"infection", -0.2});
+        for (int inactive = 0; inactive < 3; inactive++)
+            for (int active = 0; active < 100; active++)
+                for (VertexState prev = 0; prev < 2; prev++)
+                    for (VertexState next = 0; next < 2; next++)
+                        EXPECT_EQ(log(dynamics.getTransitionProb(prev, next, {inactive, active})),
+                                  dynamics.getLogTransitionProb(prev, next, {inactive, active}));
+    }
+
     TEST_F(TestSISDynamics, metropolisGraphStep_forAcceptedMove_noConsistencyError)
     {
         dynamics.sample();
         MCMCSummary summary = {};
-        while (summary.accepted.size() == 0)
+        while (summary.getAcceptedCount() == 0)
             summary.update(dynamics.metropolisGraphStep());
         dynamics.checkConsistency();
     }
@@ -98,7 +621,7 @@ namespace GraphInf
     {
         dynamics.sample();
         MCMCSummary summary = {};
-        while (summary.accepted.size() == 0)
+        while (summary.getAcceptedCount() == 0)
             summary.update(dynamics.metropolisParamStep());
         dynamics.checkConsistency();
     }
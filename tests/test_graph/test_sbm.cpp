@@ -333,6 +333,39 @@ TEST_P(SBMParametrizedTest, doingMetropolisHastingsWithLabels_expectNoConsistenc
     EXPECT_NO_THROW(doMetropolisHastingsSweepForLabels(randomGraph));
 }
 
+TEST_P(SBMParametrizedTest, getLogJointRatiosFromGraphMoves_givenThreads_returnSameAsOneByOne)
+{
+    std::vector<GraphInf::GraphMove> moves;
+    for (size_t i = 0; i < 50; i++)
+        moves.push_back(randomGraph.proposeGraphMove());
+    randomGraph.setThreadCount(4);
+    auto logJointRatios = randomGraph.getLogJointRatiosFromGraphMoves(moves);
+    for (size_t i = 0; i < moves.size(); i++)
+        EXPECT_EQ(logJointRatios[i], randomGraph.getLogJointRatioFromGraphMove(moves[i]));
+}
+
+TEST_P(SBMParametrizedTest, greedySweeps_givenSameRNG_resultIndependentOfThreadCount)
+{
+    const auto graph = randomGraph.getState();
+    const auto labels = randomGraph.getLabels();
+    GraphInf::RNG gen(7);
+    randomGraph.setRNG(gen);
+    randomGraph.greedyGraphSweep(10, 20);
+    randomGraph.greedyParamSweep(10, 20);
+    const auto expectedGraph = randomGraph.getState();
+    const auto expectedLabels = randomGraph.getLabels();
+
+    randomGraph.setState(graph);
+    randomGraph.setLabels(labels);
+    gen = GraphInf::RNG(7);
+    randomGraph.setThreadCount(4);
+    randomGraph.greedyGraphSweep(10, 20);
+    randomGraph.greedyParamSweep(10, 20);
+    EXPECT_EQ(randomGraph.getState(), expectedGraph);
+    EXPECT_EQ(randomGraph.getLabels(), expectedLabels);
+    randomGraph.checkConsistency();
+}
+
 TEST_P(SBMParametrizedTest, enumeratingAllGraphs_likelihoodIsNormalized)
 {
     size_t N = 4, E = 4, B = 0;
@@ -46,7 +46,7 @@ public:
     const double getLogLikelihoodRatioFromLabelMove(const BlockMove &move) const override { return 0; }
 
     void checkSelfConsistency() const override {}
-    bool getIsProcessed() { return m_isProcessed; }
+    bool getIsProcessed() { return isProcessed(); }
 };
 
 class BlockPriorTest : public ::testing::Test
@@ -309,7 +309,10 @@ public:
     BlockUniformHyperPrior prior = BlockUniformHyperPrior(GRAPH_SIZE, blockCountPrior);
     void SetUp()
     {
-        prior.sample();
+        // `findLabelMove` needs at least two blocks to move a vertex between.
+        do
+            prior.sample();
+        while (prior.getBlockCount() < 2);
         prior.checkSafety();
     }
     void TearDown()
@@ -116,6 +116,7 @@ namespace GraphInf
         std::cout << randomGraph.getEdgeCount() << std::endl;
         while (true)
         {
+            SetUp();
             edge = proposer.getEdgeSampler().sample();
             weight = graph.getEdgeMultiplicity(edge.first, edge.second);
             if (edge.first != edge.second)
@@ -0,0 +1,97 @@
+#include "gtest/gtest.h"
+#include <memory>
+#include <vector>
+
+#include "GraphInf/chain_pool.hpp"
+#include "GraphInf/graph/erdosrenyi.h"
+#include "GraphInf/data/dynamics/sis.h"
+
+namespace GraphInf
+{
+
+    struct SISChain
+    {
+        ErdosRenyiModel prior = ErdosRenyiModel(20, 30);
+        SISDynamics dynamics = SISDynamics(prior, 10);
+        SISChain() { dynamics.sample(); }
+    };
+
+    class TestChainPool : public ::testing::Test
+    {
+    public:
+        const size_t CHAIN_COUNT = 4, NUM_SWEEPS = 5, NUM_STEPS = 20;
+        static std::shared_ptr<RandomGraph> makeGraph(size_t chainIndex)
+        {
+            return std::make_shared<ErdosRenyiModel>(20, 30);
+        }
+        static std::shared_ptr<DataModel> makeDynamics(size_t chainIndex)
+        {
+            auto chain = std::make_shared<SISChain>();
+            return std::shared_ptr<DataModel>(chain, &chain->dynamics);
+        }
+    };
+
+    TEST_F(TestChainPool, run_givenChains_returnJoinedSummary)
+    {
+        ChainPool<RandomGraph> pool(makeGraph, CHAIN_COUNT, 1, 2);
+        auto summary = pool.run(NUM_SWEEPS, NUM_STEPS);
+
+        size_t chainTotal = 0;
+        for (const auto &s : pool.getChainSummaries())
+            chainTotal += s.getTotalCount();
+        EXPECT_EQ(summary.getTotalCount(), CHAIN_COUNT * NUM_SWEEPS * NUM_STEPS);
+        EXPECT_EQ(summary.getTotalCount(), chainTotal);
+    }
+
+    TEST_F(TestChainPool, run_givenSameMasterSeed_resultIndependentOfThreadCount)
+    {
+        seed(5);
+        ChainPool<RandomGraph> serial(makeGraph, CHAIN_COUNT, 17, 1);
+        seed(5);
+        ChainPool<RandomGraph> parallel(makeGraph, CHAIN_COUNT, 17, CHAIN_COUNT);
+        serial.run(NUM_SWEEPS, NUM_STEPS);
+        parallel.run(NUM_SWEEPS, NUM_STEPS);
+        for (size_t k = 0; k < CHAIN_COUNT; k++)
+        {
+            EXPECT_EQ(serial.getChain(k).getState(), parallel.getChain(k).getState());
+            EXPECT_EQ(serial.getChainSummaries()[k].acceptedCounts, parallel.getChainSummaries()[k].acceptedCounts);
+        }
+    }
+
+    TEST_F(TestChainPool, run_givenSinks_everySweepIsSentToItsChainSink)
+    {
+        ChainPool<DataModel> pool(makeDynamics, CHAIN_COUNT, 3, CHAIN_COUNT);
+        std::vector<std::vector<size_t>> sweeps(CHAIN_COUNT);
+        for (size_t k = 0; k < CHAIN_COUNT; k++)
+            pool.setSink(k, [&sweeps](size_t chainIndex, size_t sweep, const DataModel &model, const MCMCSummary &)
+                         { sweeps[chainIndex].push_back(sweep); });
+        pool.run(NUM_SWEEPS, NUM_STEPS);
+
+        for (size_t k = 0; k < CHAIN_COUNT; k++)
+        {
+            ASSERT_EQ(sweeps[k].size(), NUM_SWEEPS);
+            for (size_t s = 0; s < NUM_SWEEPS; s++)
+                EXPECT_EQ(sweeps[k][s], s);
+            pool.getChain(k).checkConsistency();
+        }
+    }
+
+    TEST_F(TestChainPool, getSweepsPerSecond_afterRun_returnPositiveThroughput)
+    {
+        ChainPool<RandomGraph> pool(makeGraph, CHAIN_COUNT, 1);
+        pool.run(NUM_SWEEPS, NUM_STEPS);
+        for (const auto &s : pool.getChainStatistics())
+            EXPECT_EQ(s.sweeps, NUM_SWEEPS);
+        for (auto throughput : pool.getSweepsPerSecond())
+            EXPECT_GT(throughput, 0);
+    }
+
+    TEST_F(TestChainPool, constructor_givenNullModel_throwInvalidArgument)
+    {
+        EXPECT_THROW(ChainPool<RandomGraph>([](size_t)
+                                            { return std::shared_ptr<RandomGraph>(); },
+                                            CHAIN_COUNT),
+                     std::invalid_argument);
+    }
+
+}
@@ -0,0 +1,82 @@
+#include "gtest/gtest.h"
+#include <map>
+#include <string>
+
+#include "GraphInf/mcmc.h"
+
+namespace GraphInf
+{
+
+    TEST(TestMCMCSummary, update_givenGraphMoves_countByKind)
+    {
+        MCMCSummary summary;
+        summary.update(StepResult<GraphMove>{GraphMove({}, {{0, 1}}), 1.5, true});
+        summary.update(StepResult<GraphMove>{GraphMove({}, {{0, 2}}), 2., false});
+        summary.update(StepResult<GraphMove>{GraphMove({{0, 1}}, {{1, 2}}), -1., true});
+
+        EXPECT_EQ(summary.getTotalCount(MoveKind::Added), 2);
+        EXPECT_EQ(summary.getAcceptedCount(MoveKind::Added), 1);
+        EXPECT_EQ(summary.getTotalCount(MoveKind::HingeFlip), 1);
+        EXPECT_EQ(summary.getAcceptedCount(MoveKind::HingeFlip), 1);
+        EXPECT_EQ(summary.getTotalCount(), 3);
+        EXPECT_EQ(summary.getAcceptedCount(), 2);
+        EXPECT_DOUBLE_EQ(summary.logJointRatio, 0.5);
+    }
+
+    TEST(TestMCMCSummary, getTotal_givenMixedMoves_returnCountsByAlias)
+    {
+        MCMCSummary summary;
+        summary.update(StepResult<GraphMove>{GraphMove({{0, 1}}, {}), 0, false});
+        summary.update(StepResult<BlockMove>{BlockMove(0, 0, 1), 0, true});
+        summary.update(StepResult<ParamMove>{ParamMove("infection_prob", 0.1), 0, true});
+        summary.update(StepResult<ParamMove>{ParamMove("infection_prob", -0.1), 0, false});
+        summary.update(StepResult<ParamMove>{ParamMove("recovery_prob", 0.1), 0, false});
+
+        std::map<std::string, size_t> expectedTotal = {{"removed", 1}, {"label_swap", 1}, {"param[infection_prob]", 2}, {"param[recovery_prob]", 1}};
+        std::map<std::string, size_t> expectedAccepted = {{"removed", 0}, {"label_swap", 1}, {"param[infection_prob]", 1}, {"param[recovery_prob]", 0}};
+        EXPECT_EQ(summary.getTotal(), expectedTotal);
+        EXPECT_EQ(summary.getAccepted(), expectedAccepted);
+        EXPECT_EQ(summary.getTotalCount(MoveKind::Param), 3);
+    }
+
+    TEST(TestMCMCSummary, join_givenTwoSummaries_sumCounts)
+    {
+        MCMCSummary first, second;
+        first.update(StepResult<GraphMove>{GraphMove({}, {{0, 1}}), 1, true});
+        first.update(StepResult<ParamMove>{ParamMove("coupling", 0.1), 0, true});
+        second.update(StepResult<GraphMove>{GraphMove({}, {{0, 1}}), 2, true});
+        second.update(StepResult<ParamMove>{ParamMove("coupling", 0.1), 0, false});
+        first.join(second);
+
+        EXPECT_EQ(first.getTotalCount(MoveKind::Added), 2);
+        EXPECT_EQ(first.getAcceptedCount(MoveKind::Added), 2);
+        EXPECT_EQ(first.getTotal().at("param[coupling]"), 2);
+        EXPECT_EQ(first.getAccepted().at("param[coupling]"), 1);
+        EXPECT_DOUBLE_EQ(first.logJointRatio, 3);
+    }
+
+    TEST(TestMCMCSummary, update_givenRegisteredKeyIndex_countUnderSameAliasAsKey)
+    {
+        const size_t index = ParamKeyRegistry::getIndex("mutation_prob");
+        EXPECT_EQ(ParamKeyRegistry::getIndex("mutation_prob"), index);
+
+        MCMCSummary summary;
+        summary.update(StepResult<ParamMove>{ParamMove("mutation_prob", 0.1, index), 0, true});
+        summary.update(StepResult<ParamMove>{ParamMove("mutation_prob", -0.1), 0, false});
+
+        std::map<std::string, size_t> expectedTotal = {{"param[mutation_prob]", 2}};
+        std::map<std::string, size_t> expectedAccepted = {{"param[mutation_prob]", 1}};
+        EXPECT_EQ(summary.getTotal(), expectedTotal);
+        EXPECT_EQ(summary.getAccepted(), expectedAccepted);
+    }
+
+    TEST(TestMCMCSummary, alias_givenMoveKind_matchKindName)
+    {
+        EXPECT_EQ(GraphMove().alias(), "none");
+        EXPECT_EQ(GraphMove({{0, 1}, {2, 3}}, {{0, 2}, {1, 3}}).alias(), "double_edge_flip");
+        EXPECT_EQ(GraphMove({{0, 1}, {2, 3}, {4, 5}}, {}).alias(), "multiflip");
+        EXPECT_EQ(BlockMove().alias(), "label_swap");
+        EXPECT_EQ(ParamMove("beta").alias(), "param[beta]");
+    }
+
+}
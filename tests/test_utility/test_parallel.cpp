@@ -0,0 +1,36 @@
+#include "gtest/gtest.h"
+#include <cmath>
+#include <vector>
+
+#include "GraphInf/utility/parallel.hpp"
+
+namespace GraphInf
+{
+
+    TEST(TestParallel, parallelForBlocks_givenCount_visitEveryIndexOnce)
+    {
+        ThreadPool pool(4);
+        std::vector<size_t> visits(1001, 0);
+        parallelForBlocks(pool, visits.size(), 64, [&](size_t begin, size_t end)
+                          {
+                              EXPECT_LE(end - begin, 64);
+                              for (size_t i = begin; i < end; i++)
+                                  visits[i]++; });
+        for (auto count : visits)
+            EXPECT_EQ(count, 1);
+    }
+
+    TEST(TestParallel, parallelSum_givenThreadCounts_sameSum)
+    {
+        const auto term = [](size_t i)
+        { return std::log(1 + i) / (1 + i % 7); };
+        ThreadPool serialPool(1);
+        const double expected = parallelSum(serialPool, 10000, 64, term);
+        for (size_t threadCount : {2, 3, 8})
+        {
+            ThreadPool pool(threadCount);
+            EXPECT_EQ(parallelSum(pool, 10000, 64, term), expected);
+        }
+    }
+
+}
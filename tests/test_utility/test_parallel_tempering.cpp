@@ -0,0 +1,123 @@
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "GraphInf/parallel_tempering.hpp"
+#include "GraphInf/graph/erdosrenyi.h"
+#include "GraphInf/data/dynamics/sis.h"
+
+namespace GraphInf
+{
+
+    struct SISReplica
+    {
+        ErdosRenyiModel prior = ErdosRenyiModel(20, 30);
+        SISDynamics dynamics = SISDynamics(prior, 20, 0.3, 0.2);
+        SISReplica() { dynamics.sample(); }
+    };
+
+    class TestParallelTempering : public ::testing::Test
+    {
+    public:
+        const size_t REPLICA_COUNT = 4, NUM_ROUNDS = 20, NUM_STEPS = 20;
+        static std::shared_ptr<DataModel> makeReplica(size_t replicaIndex)
+        {
+            auto replica = std::make_shared<SISReplica>();
+            return std::shared_ptr<DataModel>(replica, &replica->dynamics);
+        }
+        void SetUp() { seed(7); }
+    };
+
+    TEST_F(TestParallelTempering, makeGeometricLadder_givenMinBeta_returnDecreasingLadderWithFixedEnds)
+    {
+        auto betas = ParallelTempering<DataModel>::makeGeometricLadder(5, 0.01);
+        ASSERT_EQ(betas.size(), 5);
+        EXPECT_DOUBLE_EQ(betas.front(), 1);
+        EXPECT_DOUBLE_EQ(betas.back(), 0.01);
+        for (size_t l = 1; l < betas.size(); l++)
+            EXPECT_DOUBLE_EQ(betas[l] / betas[l - 1], 0.01 / betas[betas.size() - 2]);
+    }
+
+    TEST_F(TestParallelTempering, constructor_givenNonDecreasingBetas_throwInvalidArgument)
+    {
+        EXPECT_THROW(ParallelTempering<DataModel>(makeReplica, {1, 0.5, 0.5}), std::invalid_argument);
+        EXPECT_THROW(ParallelTempering<DataModel>(makeReplica, {}), std::invalid_argument);
+    }
+
+    TEST_F(TestParallelTempering, run_givenLadder_everyPairIsAttemptedEveryRound)
+    {
+        ParallelTempering<DataModel> pt(makeReplica, ParallelTempering<DataModel>::makeGeometricLadder(REPLICA_COUNT, 0.1), 3);
+        auto summary = pt.run(NUM_ROUNDS, NUM_STEPS);
+
+        // One graph and one prior label move per step.
+        EXPECT_EQ(summary.getTotalCount(), 2 * NUM_ROUNDS * NUM_STEPS);
+        for (const auto &s : pt.getSwapStatistics())
+            EXPECT_EQ(s.attempted, NUM_ROUNDS);
+
+        auto replicas = pt.getReplicaAtLevel();
+        std::sort(replicas.begin(), replicas.end());
+        for (size_t r = 0; r < REPLICA_COUNT; r++)
+            EXPECT_EQ(replicas[r], r);
+        for (size_t r = 0; r < REPLICA_COUNT; r++)
+            EXPECT_DOUBLE_EQ(pt.getLogLikelihoods()[r], pt.getReplica(r).getLogLikelihood());
+    }
+
+    TEST_F(TestParallelTempering, run_givenCloseBetas_swapsAreAlmostAlwaysAccepted)
+    {
+        ParallelTempering<DataModel> pt(makeReplica, {1, 1 - 1e-9}, 3);
+        pt.run(NUM_ROUNDS, NUM_STEPS);
+        EXPECT_EQ(pt.getSwapStatistics()[0].accepted, NUM_ROUNDS);
+    }
+
+    TEST_F(TestParallelTempering, run_givenSameMasterSeed_resultIndependentOfThreadCount)
+    {
+        auto betas = ParallelTempering<DataModel>::makeGeometricLadder(REPLICA_COUNT, 0.1);
+        seed(5);
+        ParallelTempering<DataModel> serial(makeReplica, betas, 17, 1, 1);
+        seed(5);
+        ParallelTempering<DataModel> parallel(makeReplica, betas, 17, 1, REPLICA_COUNT);
+        serial.setAdaptation(NUM_ROUNDS);
+        parallel.setAdaptation(NUM_ROUNDS);
+        serial.run(NUM_ROUNDS, NUM_STEPS);
+        parallel.run(NUM_ROUNDS, NUM_STEPS);
+
+        EXPECT_EQ(serial.getReplicaAtLevel(), parallel.getReplicaAtLevel());
+        EXPECT_EQ(serial.getBetas(), parallel.getBetas());
+        for (size_t r = 0; r < REPLICA_COUNT; r++)
+            EXPECT_EQ(serial.getReplica(r).getGraph(), parallel.getReplica(r).getGraph());
+    }
+
+    TEST_F(TestParallelTempering, run_withAdaptation_keepEndsAndOrdering)
+    {
+        ParallelTempering<DataModel> pt(makeReplica, ParallelTempering<DataModel>::makeGeometricLadder(REPLICA_COUNT, 0.01), 3);
+        auto initialBetas = pt.getBetas();
+        pt.setAdaptation(NUM_ROUNDS, 1, 10);
+        pt.run(NUM_ROUNDS, NUM_STEPS);
+
+        EXPECT_FALSE(pt.isAdapting());
+        const auto &betas = pt.getBetas();
+        EXPECT_DOUBLE_EQ(betas.front(), initialBetas.front());
+        EXPECT_DOUBLE_EQ(betas.back(), initialBetas.back());
+        for (size_t l = 1; l < betas.size(); l++)
+            EXPECT_LT(betas[l], betas[l - 1]);
+        EXPECT_NE(betas, initialBetas);
+
+        auto adaptedBetas = betas;
+        pt.run(NUM_ROUNDS, NUM_STEPS);
+        EXPECT_EQ(pt.getBetas(), adaptedBetas);
+    }
+
+    TEST_F(TestParallelTempering, setSink_afterRun_receiveColdReplicaEveryRound)
+    {
+        ParallelTempering<DataModel> pt(makeReplica, ParallelTempering<DataModel>::makeGeometricLadder(REPLICA_COUNT, 0.1), 3);
+        std::vector<size_t> rounds;
+        pt.setSink([&rounds](size_t round, const DataModel &model, const MCMCSummary &)
+                   { rounds.push_back(round); model.checkConsistency(); });
+        pt.run(NUM_ROUNDS, NUM_STEPS);
+        ASSERT_EQ(rounds.size(), NUM_ROUNDS);
+        for (size_t i = 0; i < NUM_ROUNDS; i++)
+            EXPECT_EQ(rounds[i], i);
+    }
+
+}
@@ -0,0 +1,113 @@
+#include "gtest/gtest.h"
+#include <vector>
+#include <algorithm>
+
+#include "GraphInf/rng.h"
+#include "GraphInf/utility/philox.h"
+#include "GraphInf/graph/sbm.h"
+
+namespace GraphInf
+{
+
+    static std::vector<RNG::result_type> drawFrom(RNG &gen, size_t n)
+    {
+        std::vector<RNG::result_type> draws;
+        for (size_t i = 0; i < n; i++)
+            draws.push_back(gen());
+        return draws;
+    }
+
+    TEST(TestRNGStreams, makeRNGStream_givenSameSeedAndIndex_returnSameStream)
+    {
+        RNG first = makeRNGStream(42, 3), second = makeRNGStream(42, 3);
+        EXPECT_EQ(drawFrom(first, 10), drawFrom(second, 10));
+    }
+
+    TEST(TestRNGStreams, makeRNGStream_givenIndexZero_returnSeededGenerator)
+    {
+        RNG stream = makeRNGStream(42, 0), seeded(42);
+        EXPECT_EQ(stream, seeded);
+    }
+
+    TEST(TestRNGStreams, makeRNGStreams_givenMasterSeed_matchIndividualStreams)
+    {
+        auto streams = makeRNGStreams(7, 4);
+        ASSERT_EQ(streams.size(), 4);
+        for (size_t k = 0; k < streams.size(); k++)
+            EXPECT_EQ(streams[k], makeRNGStream(7, k));
+    }
+
+    TEST(TestRNGStreams, makeRNGStreams_givenMasterSeed_streamsAreDistinct)
+    {
+        auto streams = makeRNGStreams(7, 4);
+        std::vector<std::vector<RNG::result_type>> draws;
+        for (auto &stream : streams)
+            draws.push_back(drawFrom(stream, 10));
+        for (size_t i = 0; i < draws.size(); i++)
+            for (size_t j = i + 1; j < draws.size(); j++)
+                EXPECT_NE(draws[i], draws[j]);
+    }
+
+    TEST(TestRNGStreams, setRNG_givenTwoModelsWithSameStream_sampleSameGraph)
+    {
+        StochasticBlockModelFamily first(20, 30, 3), second(20, 30, 3);
+
+        RNG firstStream = makeRNGStream(11, 1), secondStream = makeRNGStream(11, 1);
+        first.setRNG(firstStream);
+        second.setRNG(secondStream);
+
+        first.sample();
+        rng();
+        second.sample();
+        EXPECT_EQ(first.getLabels(), second.getLabels());
+        EXPECT_EQ(first.getState(), second.getState());
+
+        for (size_t i = 0; i < 10; i++)
+        {
+            auto firstResult = first.metropolisGraphStep();
+            auto secondResult = second.metropolisGraphStep();
+            EXPECT_EQ(firstResult.move.addedEdges, secondResult.move.addedEdges);
+            EXPECT_EQ(firstResult.move.removedEdges, secondResult.move.removedEdges);
+            EXPECT_EQ(firstResult.accepted, secondResult.accepted);
+        }
+        EXPECT_EQ(firstStream, secondStream);
+    }
+
+    TEST(TestRNGStreams, setRNG_givenOwnStream_leaveGlobalRNGUntouched)
+    {
+        StochasticBlockModelFamily model(20, 30, 3);
+        RNG stream = makeRNGStream(3, 2);
+        model.setRNG(stream);
+
+        RNG globalBefore = rng;
+        model.sample();
+        model.metropolisGraphSweep(10);
+        model.metropolisParamSweep(10);
+        EXPECT_EQ(rng, globalBefore);
+    }
+
+    TEST(TestPhilox, generate_givenZeroCounterAndKey_returnReferenceOutput)
+    {
+        // Known-answer vector of the Random123 distribution.
+        const Philox4x32::Counter expected = {{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}};
+        EXPECT_EQ(Philox4x32::generate({{0, 0, 0, 0}}, {{0, 0}}), expected);
+    }
+
+    TEST(TestPhilox, uniform_givenCounters_returnDistinctValuesInUnitInterval)
+    {
+        std::vector<double> draws;
+        for (uint64_t step = 0; step < 10; step++)
+            for (uint64_t vertex = 0; vertex < 10; vertex++)
+            {
+                const double draw = Philox4x32::uniform(42, step, vertex);
+                EXPECT_LE(0, draw);
+                EXPECT_LT(draw, 1);
+                EXPECT_EQ(draw, Philox4x32::uniform(42, step, vertex));
+                EXPECT_NE(draw, Philox4x32::uniform(43, step, vertex));
+                draws.push_back(draw);
+            }
+        std::sort(draws.begin(), draws.end());
+        EXPECT_EQ(std::unique(draws.begin(), draws.end()), draws.end());
+    }
+
+}
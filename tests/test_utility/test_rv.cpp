@@ -0,0 +1,84 @@
+#include "gtest/gtest.h"
+#include <vector>
+
+#include "GraphInf/rv.hpp"
+
+namespace GraphInf
+{
+
+    /* Variable whose value sums its children's, counting how many times it is
+     * evaluated; `m_nested` is an independent root evaluated in the middle. */
+    class CountedVariable : public NestedRandomVariable
+    {
+        std::vector<const CountedVariable *> m_children;
+        const CountedVariable *m_nested = nullptr;
+
+    public:
+        mutable size_t evaluations = 0;
+
+        void addChild(CountedVariable &child)
+        {
+            child.isRoot(false);
+            m_children.push_back(&child);
+        }
+        void setNested(const CountedVariable &nested) { m_nested = &nested; }
+        bool getIsProcessed() const { return isProcessed(); }
+
+        const size_t getValue() const
+        {
+            return processRecursiveConstFunction<size_t>([&]()
+                                                         {
+                                                             evaluations++;
+                                                             size_t value = 1;
+                                                             for (size_t i = 0; i < m_children.size(); i++)
+                                                             {
+                                                                 if (i == 1 and m_nested)
+                                                                     m_nested->getValue();
+                                                                 value += m_children[i]->getValue();
+                                                             }
+                                                             return value; },
+                                                         0);
+        }
+        void computationFinished() const override
+        {
+            NestedRandomVariable::computationFinished();
+            for (auto child : m_children)
+                child->computationFinished();
+        }
+    };
+
+    TEST(TestNestedRandomVariable, getValue_givenSharedChild_evaluateItOnce)
+    {
+        CountedVariable root, left, right, shared;
+        root.addChild(left);
+        root.addChild(right);
+        left.addChild(shared);
+        right.addChild(shared);
+
+        EXPECT_EQ(root.getValue(), 4);
+        EXPECT_EQ(shared.evaluations, 1);
+        EXPECT_FALSE(left.getIsProcessed());
+        EXPECT_FALSE(shared.getIsProcessed());
+
+        EXPECT_EQ(root.getValue(), 4);
+        EXPECT_EQ(shared.evaluations, 2);
+    }
+
+    TEST(TestNestedRandomVariable, getValue_givenNestedRootComputation_keepOuterVariablesProcessed)
+    {
+        CountedVariable root, left, right, shared, nestedRoot, nestedChild;
+        root.addChild(left);
+        root.addChild(right);
+        left.addChild(shared);
+        right.addChild(shared);
+        nestedRoot.addChild(nestedChild);
+        root.setNested(nestedRoot);
+
+        EXPECT_EQ(root.getValue(), 4);
+        EXPECT_EQ(shared.evaluations, 1);
+        EXPECT_EQ(nestedChild.evaluations, 1);
+        EXPECT_FALSE(shared.getIsProcessed());
+        EXPECT_FALSE(nestedChild.getIsProcessed());
+    }
+
+}
@@ -0,0 +1,56 @@
+#include "gtest/gtest.h"
+#include <vector>
+
+#include "GraphInf/utility/small_vector.hpp"
+#include "GraphInf/mcmc.h"
+
+namespace GraphInf
+{
+
+    TEST(TestSmallVector, pushBack_withinInlineCapacity_stayInline)
+    {
+        SmallVector<int, 2> values;
+        values.push_back(1);
+        values.push_back(2);
+        EXPECT_TRUE(values.isInline());
+        EXPECT_EQ(values.toVector(), std::vector<int>({1, 2}));
+    }
+
+    TEST(TestSmallVector, pushBack_beyondInlineCapacity_keepElementsOnHeap)
+    {
+        SmallVector<int, 2> values = {1, 2};
+        values.push_back(3);
+        EXPECT_FALSE(values.isInline());
+        EXPECT_EQ(values.size(), 3);
+        EXPECT_EQ(values.toVector(), std::vector<int>({1, 2, 3}));
+
+        values.pop_back();
+        EXPECT_EQ(values.back(), 2);
+        values.clear();
+        EXPECT_TRUE(values.empty());
+        EXPECT_TRUE(values.isInline());
+    }
+
+    TEST(TestSmallVector, copy_givenHeapValues_copyElements)
+    {
+        SmallVector<int, 2> values = {1, 2, 3}, copy = values;
+        copy[0] = 4;
+        EXPECT_EQ(values.toVector(), std::vector<int>({1, 2, 3}));
+        EXPECT_EQ(copy.toVector(), std::vector<int>({4, 2, 3}));
+        EXPECT_NE(values, copy);
+        EXPECT_THROW(copy.at(3), std::out_of_range);
+    }
+
+    TEST(TestSmallVector, graphMove_givenVectorsOfEdges_keepEdgesAndAlias)
+    {
+        std::vector<BaseGraph::Edge> removed = {{0, 1}, {2, 3}}, added = {{0, 2}, {1, 3}};
+        GraphMove move(removed, added);
+        EXPECT_TRUE(move.removedEdges.isInline());
+        EXPECT_TRUE(move.addedEdges.isInline());
+        EXPECT_EQ(move.removedEdges.toVector(), removed);
+        EXPECT_EQ(move.addedEdges.toVector(), added);
+        EXPECT_EQ(move.alias(), "double_edge_flip");
+        EXPECT_TRUE(move == GraphMove({{0, 1}, {2, 3}}, {{0, 2}, {1, 3}}));
+    }
+
+}
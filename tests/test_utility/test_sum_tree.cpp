@@ -0,0 +1,43 @@
+#include "gtest/gtest.h"
+#include <vector>
+
+#include "GraphInf/utility/sum_tree.hpp"
+
+namespace GraphInf
+{
+
+    TEST(TestSumTree, set_givenWeights_returnTotal)
+    {
+        SumTree tree(5);
+        tree.set(0, 1);
+        tree.set(3, 2.5);
+        tree.set(4, 0.5);
+        EXPECT_EQ(tree.getTotal(), 4);
+        tree.set(3, 0);
+        EXPECT_EQ(tree.getTotal(), 1.5);
+        EXPECT_EQ(tree.get(4), 0.5);
+    }
+
+    TEST(TestSumTree, sample_givenUniforms_returnIndexOfCumulativeInterval)
+    {
+        SumTree tree(5);
+        tree.set(1, 1);
+        tree.set(2, 2);
+        tree.set(4, 1);
+        EXPECT_EQ(tree.sample(0), 1);
+        EXPECT_EQ(tree.sample(0.2), 1);
+        EXPECT_EQ(tree.sample(0.3), 2);
+        EXPECT_EQ(tree.sample(0.7), 2);
+        EXPECT_EQ(tree.sample(0.8), 4);
+        EXPECT_EQ(tree.sample(0.9999999), 4);
+    }
+
+    TEST(TestSumTree, sample_givenZeroWeights_neverReturnThem)
+    {
+        SumTree tree(7);
+        tree.set(0, 1);
+        for (double uniform = 0; uniform < 1; uniform += 0.01)
+            EXPECT_EQ(tree.sample(uniform), 0);
+    }
+
+}